@@ -8,13 +8,31 @@
 #include <glm/gtx/quaternion.hpp>
 
 #include <coroutine>
+#include <functional>
 #include <optional>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <span>
 #include <variant>
+#include <vector>
+
+// How the renderer calculates the volume of a request
+enum class EvaluationMode
+{
+  Full,      // selected backend (raster or ray traced)
+  Analytic,  // per-facet estimate, falls back to Full when occlusion is ambiguous
+};
 
 struct AlgoRequestBase
 {
-  bool skipCalculation = false;
+  bool           skipCalculation = false;
+  EvaluationMode evaluationMode  = EvaluationMode::Full;
+  int            lod             = 0;  // level of detail of the mesh, 0 is the full mesh
+  int            resolutionLevel = 0;  // grid resolution is halved per level, 0 is the selected resolution
+
+  // Mode, level of detail and resolution level are the fidelity of the request
+  bool isFullFidelity() const { return evaluationMode == EvaluationMode::Full && lod == 0 && resolutionLevel == 0; }
 };
 
 struct AlgoRequestNewPos : public AlgoRequestBase
@@ -33,7 +51,14 @@ struct AlgoRequestMoveDir : public AlgoRequestBase
   shaderio::float2 moveDirection;
 };
 
-using AlgoRequestAny = std::variant<AlgoRequestNewPos, AlgoRequestNewQuat, AlgoRequestMoveDir>;
+// Several rotations evaluated before the algorithm is resumed
+// Camera is left at the last rotation
+struct AlgoRequestBatch : public AlgoRequestBase
+{
+  std::vector<glm::quat> rotations;
+};
+
+using AlgoRequestAny = std::variant<AlgoRequestNewPos, AlgoRequestNewQuat, AlgoRequestMoveDir, AlgoRequestBatch>;
 
 struct RendererResult
 {
@@ -56,6 +81,7 @@ struct AlgoTask
 
     std::optional<AlgoRequestAny> algo_request;
     RendererResult                renderer_result{};
+    std::vector<RendererResult>   renderer_results{};  // AlgoRequestBatch
     AlgoResult                    algo_result{};
 
     AlgoTask            get_return_object() { return std::coroutine_handle<promise_type>::from_promise(*this); }
@@ -107,6 +133,24 @@ struct AlgoTask
     }
   };
 
+  // Compute with AlgoRequestBatch, resumes with one result per rotation
+  struct ComputeBatch : Compute
+  {
+    bool await_ready() { return std::get<AlgoRequestBatch>(req).rotations.empty(); }
+
+    std::vector<RendererResult> await_resume()
+    {
+      // Empty batch is never sent
+      if(!h)
+        return {};
+
+      auto cur = h;
+      while(cur.promise().parent)
+        cur = cur.promise().parent;
+      return std::move(cur.promise().renderer_results);
+    }
+  };
+
   std::coroutine_handle<promise_type> h;
 
   bool                    await_ready() { return false; }
@@ -150,6 +194,12 @@ struct AlgoTask
 class Algorithm
 {
 public:
+  // Volume of a rotation can't be below the bound (e.g. from the convex hull of the mesh)
+  using LowerBound = std::function<float(const glm::quat&)>;
+
+  // Cheap estimate of the volume (e.g. overhang area) for ranking rotations, not comparable with volumes
+  using Proxy = std::function<float(const glm::quat&)>;
+
   AlgoTask run() { return algorithmLogic(); }
 
 protected:
@@ -159,6 +209,25 @@ protected:
   float     bestVolume = std::numeric_limits<float>::max();
   glm::quat bestRotation{};
 
+  // Used by all following requests
+  EvaluationMode evaluationMode  = EvaluationMode::Full;
+  int            lod             = 0;
+  int            resolutionLevel = 0;
+
+  LowerBound lowerBound;
+  int        prunedCount = 0;
+
+  Proxy proxy;
+
+  // Camera positions likely to be good (e.g. a large face on the bed), best first
+  std::vector<glm::vec3> seedDirections;
+
+  // Best volume minus a lower bound of the global minimum, relative to the best volume
+  std::optional<float> optimalityGap;
+
+  // Renderer evaluations of the cached deterministic run on the same mesh with the same settings
+  std::optional<int> deterministicIterations;
+
   Algorithm() {}
 
   void storeRequest(RendererResult result)
@@ -172,7 +241,8 @@ public:
   // Wait for resulting volume
   AlgoTask requestVolumeForQuat(glm::quat newQuat, bool skipCalculation = false)
   {
-    storeRequest(co_await AlgoTask::Compute{AlgoRequestNewQuat{skipCalculation, newQuat}});
+    storeRequest(
+        co_await AlgoTask::Compute{AlgoRequestNewQuat{{skipCalculation, evaluationMode, lod, resolutionLevel}, newQuat}});
     co_return {};
   }
 
@@ -180,7 +250,8 @@ public:
   // Wait for resulting volume
   AlgoTask requestVolumeForPosition(shaderio::float3 newPosition, bool skipCalculation = false)
   {
-    storeRequest(co_await AlgoTask::Compute{AlgoRequestNewPos{skipCalculation, newPosition}});
+    storeRequest(
+        co_await AlgoTask::Compute{AlgoRequestNewPos{{skipCalculation, evaluationMode, lod, resolutionLevel}, newPosition}});
     co_return {};
   }
 
@@ -188,13 +259,77 @@ public:
   // Wait for resulting volume
   AlgoTask requestVolumeForMove(shaderio::float2 move, bool skipCalculation = false)
   {
-    storeRequest(co_await AlgoTask::Compute{AlgoRequestMoveDir{skipCalculation, move}});
+    storeRequest(
+        co_await AlgoTask::Compute{AlgoRequestMoveDir{{skipCalculation, evaluationMode, lod, resolutionLevel}, move}});
     co_return {};
   }
 
+  // Request volumes of several rotations at once, the renderer can evaluate them without waiting for the algorithm
+  // Current volume/rotation are not updated, the camera is left at the last rotation
+  AlgoTask::ComputeBatch requestVolumesForBatch(std::span<const glm::quat> rotations)
+  {
+    return {{AlgoRequestBatch{{false, evaluationMode, lod, resolutionLevel}, {rotations.begin(), rotations.end()}}}};
+  }
+
   // Loop
   virtual AlgoTask algorithmLogic() = 0;
 
+  // Same result for the same inputs (runs can be reused from the persistent cache)
+  virtual bool isDeterministic() const { return true; }
+
+  // Select how the following requests are evaluated (e.g. analytic estimate for a coarse global stage)
+  void           setEvaluationMode(EvaluationMode mode) { evaluationMode = mode; }
+  EvaluationMode getEvaluationMode() { return evaluationMode; }
+
+  // Select the level of detail of the mesh for the following requests (e.g. coarse for a global sweep)
+  // 0 is the full mesh, the renderer uses its coarsest level when fewer levels were built
+  void setLod(int level) { lod = level; }
+  int  getLod() { return lod; }
+
+  // Select the grid resolution of the following requests, halved per level (e.g. coarse for a global sweep)
+  // 0 is the resolution selected by voxelSpacing/textureResolution
+  void setResolutionLevel(int level) { resolutionLevel = level; }
+  int  getResolutionLevel() { return resolutionLevel; }
+
+  void setLowerBound(LowerBound bound) { lowerBound = std::move(bound); }
+
+  void setSeedDirections(std::vector<glm::vec3> directions) { seedDirections = std::move(directions); }
+
+  void setProxy(Proxy estimate) { proxy = std::move(estimate); }
+
+  void setDeterministicIterations(int iterations) { deterministicIterations = iterations; }
+  bool hasProxy() const { return (bool)proxy; }
+
+  // Pre-filter: true for the rotations outside the best fraction of rotations by the proxy
+  // Always false without a proxy or with fraction >= 1
+  std::function<bool(const glm::quat&)> proxyFilter(std::span<const glm::quat> rotations, float fraction) const
+  {
+    if(!proxy || fraction >= 1.0f || rotations.empty())
+      return [](const glm::quat&) { return false; };
+
+    std::vector<float> values;
+    values.reserve(rotations.size());
+    for(const auto& rotation : rotations)
+      values.push_back(proxy(rotation));
+
+    const size_t keep = std::clamp<size_t>(size_t(std::ceil(fraction * rotations.size())), 1, rotations.size());
+    std::nth_element(values.begin(), values.begin() + (keep - 1), values.end());
+    return [estimate = proxy, threshold = values[keep - 1]](const glm::quat& rotation) { return estimate(rotation) > threshold; };
+  }
+
+  // Branch and bound: true if the rotation can't get below threshold, it doesn't have to be evaluated
+  bool canPrune(const glm::quat& rotation, float threshold)
+  {
+    if(!lowerBound || lowerBound(rotation) < threshold)
+      return false;
+    prunedCount++;
+    return true;
+  }
+  int getPrunedCount() const { return prunedCount; }
+
+  // Only set by algorithms with a bound of the global minimum
+  std::optional<float> getOptimalityGap() const { return optimalityGap; }
+
   float getCurrentVolume() { return currentVolume; }
 
   glm::quat getCurrentRotation() { return currentRotation; }
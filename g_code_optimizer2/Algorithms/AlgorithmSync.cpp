@@ -3,7 +3,19 @@
 #include "BasicAlgorithm.hpp"
 #include "DeterministicAlgorithm.hpp"
 #include "StochasticAlgorithm.hpp"
+#include "CmaesAlgorithm.hpp"
+#include "SurrogateAlgorithm.hpp"
+#include "EvolutionAlgorithm.hpp"
+#include "DirectAlgorithm.hpp"
+#include "MultiFidelityAlgorithm.hpp"
 #include "PythonAlgoSync.hpp"
+#include "include/app_config.hpp"
+#include "include/hash_helpers.hpp"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <sstream>
 
 AlgoTask startAlgorithmTask(AlgorithmType algoType, std::unique_ptr<Algorithm>& algoOwner)
 {
@@ -23,6 +35,21 @@ AlgoTask startAlgorithmTask(AlgorithmType algoType, std::unique_ptr<Algorithm>&
     case AlgorithmType::Stochastic:
       algoOwner = std::make_unique<StochasticAlgorithm>();
       break;
+    case AlgorithmType::Cmaes:
+      algoOwner = std::make_unique<CmaesAlgorithm>();
+      break;
+    case AlgorithmType::Surrogate:
+      algoOwner = std::make_unique<SurrogateAlgorithm>();
+      break;
+    case AlgorithmType::Evolution:
+      algoOwner = std::make_unique<EvolutionAlgorithm>();
+      break;
+    case AlgorithmType::Direct:
+      algoOwner = std::make_unique<DirectAlgorithm>();
+      break;
+    case AlgorithmType::MultiFidelity:
+      algoOwner = std::make_unique<MultiFidelityAlgorithm>();
+      break;
     case AlgorithmType::Python:
       algoOwner = std::make_unique<PythonAlgoSync>();
       break;
@@ -33,21 +60,83 @@ AlgoTask startAlgorithmTask(AlgorithmType algoType, std::unique_ptr<Algorithm>&
   return algoOwner->run();
 }
 
-AlgoRequestAny AlgorithmSync::startAlgorithm(AlgorithmType algoType, unsigned int maxEvals)
+namespace {
+// Hash of all algorithm configurations, a changed parameter invalidates the cached runs
+uint64_t hashAlgorithmConfigs()
+{
+  std::vector<std::filesystem::path> files;
+  if(std::filesystem::exists(AppConfig::instance().getAlgorithmsPath()))
+  {
+    for(const auto& entry : std::filesystem::directory_iterator(AppConfig::instance().getAlgorithmsPath()))
+      if(entry.is_regular_file())
+        files.push_back(entry.path());
+  }
+  std::sort(files.begin(), files.end());
+
+  uint64_t hash = FNV_OFFSET_BASIS;
+  for(const auto& file : files)
+  {
+    std::ifstream      in(file, std::ios::binary);
+    std::ostringstream content;
+    content << in.rdbuf();
+    hash = hashString(file.filename().string(), hash);
+    hash = hashString(content.str(), hash);
+  }
+  return hash;
+}
+}  // namespace
+
+AlgoRequestAny AlgorithmSync::startAlgorithm(AlgorithmType algoType, unsigned int maxEvals, const EvaluationCacheSettings& cacheSettings)
 {
   stopAlgorithm();
   this->maxEvals = maxEvals;
   task           = startAlgorithmTask(algoType, algorithm);
+  algorithm->setLowerBound(lowerBound);
+  algorithm->setSeedDirections(seedDirections);
+  algorithm->setProxy(proxy);
+
+  cache.reset(cacheSettings.tolerance);
+  cameraRotation.reset();
+  pendingStore = false;
+  cachedRun.reset();
+  bestResult.reset();
+
+  cacheFile = cacheSettings.file;
+  runKey.clear();
+  if(cache.isEnabled() && !cacheFile.empty())
+  {
+    cache.load(cacheFile);
+    if(algorithm->isDeterministic())
+      runKey = makeRunKey(algoType, maxEvals, cacheSettings);
 
-  auto& h = task->h;
-  auto& p = h.promise();
+    // Deterministic run with the same settings on this mesh, for comparison
+    const EvaluationCache::CachedRun* deterministicRun =
+        cache.findRun(makeRunKey(AlgorithmType::Deterministic, maxEvals, cacheSettings));
+    if(deterministicRun && deterministicRun->iterations >= 0)
+      algorithm->setDeterministicIterations(deterministicRun->iterations);
+  }
 
-  h.resume();
   algorithmRunning = true;
   forceDone        = false;
   iterationCount   = 0;
 
-  return p.algo_request.value();
+  // Same run was already done
+  if(const EvaluationCache::CachedRun* run = runKey.empty() ? nullptr : cache.findRun(runKey))
+  {
+    std::cout << "Algorithm result loaded from the cache\n";
+    cachedRun  = *run;
+    bestResult = run->best;
+    return AlgoRequestAny{};
+  }
+
+  task->h.resume();
+  return nextRendererRequest();
+}
+
+std::string AlgorithmSync::makeRunKey(AlgorithmType algoType, unsigned int maxEvals, const EvaluationCacheSettings& cacheSettings) const
+{
+  return std::format("{}:{}:{}:{}:{:016x}:{:016x}", (int)algoType, maxEvals, cacheSettings.tolerance, rollInvariant,
+                     hashAlgorithmConfigs(), hashString(cacheSettings.runSettings));
 }
 
 void AlgorithmSync::stopAlgorithm()
@@ -55,14 +144,62 @@ void AlgorithmSync::stopAlgorithm()
   if(!isAlgorithmRunning())
     return;
 
+  // Only runs that finished on their own are repeatable
+  if(!runKey.empty() && !cachedRun && task->h.done() && bestResult)
+    cache.storeRun(runKey, {task->h.promise().algo_result, *bestResult, iterationCount});
+
+  if(!cacheFile.empty())
+  {
+    try
+    {
+      cache.save(cacheFile);
+    }
+    catch(const std::exception& e)
+    {
+      std::cerr << e.what() << "\n";
+    }
+  }
+
   task.reset();
   algorithm.reset();
   algorithmRunning = false;
 
   std::cout << "Total algorithm iterations: " << iterationCount << "\n";
+  if(cache.isEnabled())
+    std::cout << "Evaluation cache hits: " << cache.getHits() << "/" << cache.getLookups() << "\n";
 }
 
 AlgoRequestAny AlgorithmSync::runAlgorithm(RendererResult result)
+{
+  cameraRotation = result.rotation;
+  if(pendingStore)
+  {
+    cache.store(result.rotation, pendingMode, pendingLod, pendingResolution, result.volume);
+    updateBestResult(result, {false, pendingMode, pendingLod, pendingResolution});
+  }
+  pendingStore = false;
+
+  task->h.promise().renderer_result = result;
+  return resumeAlgorithm();
+}
+
+AlgoRequestAny AlgorithmSync::runAlgorithm(std::vector<RendererResult> results)
+{
+  // Merge with the cache hits
+  for(size_t i = 0; i < results.size() && i < pendingBatchMisses.size(); ++i)
+  {
+    pendingBatch[pendingBatchMisses[i]] = results[i];
+    cache.store(results[i].rotation, pendingMode, pendingLod, pendingResolution, results[i].volume);
+    updateBestResult(results[i], {false, pendingMode, pendingLod, pendingResolution});
+  }
+  if(!results.empty())
+    cameraRotation = results.back().rotation;
+
+  task->h.promise().renderer_results = std::move(pendingBatch);
+  return resumeAlgorithm();
+}
+
+AlgoRequestAny AlgorithmSync::resumeAlgorithm()
 {
   if(maxEvals > 0 && iterationCount >= maxEvals)
   {
@@ -70,18 +207,126 @@ AlgoRequestAny AlgorithmSync::runAlgorithm(RendererResult result)
     return AlgoRequestAny{};
   }
 
-  auto& h = task->h;
-  auto& p = h.promise();
-
-  p.renderer_result = result;
+  auto& p = task->h.promise();
   p.algo_request.reset();
   p.active.resume();
 
-  if(isAlgorithmDone())
-    return AlgoRequestAny{};
+  return nextRendererRequest();
+}
+
+AlgoRequestAny AlgorithmSync::nextRendererRequest()
+{
+  while(!isAlgorithmDone())
+  {
+    auto& p       = task->h.promise();
+    auto& request = p.algo_request.value();
+    if(!answerFromCache(request))
+    {
+      std::visit(overloaded{
+                     [this](AlgoRequestBatch& r) {
+                       // Only the rest of maxEvals is evaluated, the algorithm is not resumed after the last batch
+                       if(maxEvals > 0 && iterationCount + (int)r.rotations.size() > maxEvals)
+                       {
+                         r.rotations.resize(std::max(maxEvals - iterationCount, 0));
+                         pendingBatchMisses.resize(r.rotations.size());
+                       }
+                       iterationCount += (int)r.rotations.size();
+                     },
+                     [this](AlgoRequestBase& r) { iterationCount += !r.skipCalculation; },
+                 },
+                 request);
+      return request;
+    }
+
+    p.algo_request.reset();
+    p.active.resume();
+  }
+  return AlgoRequestAny{};
+}
+
+bool AlgorithmSync::answerFromCache(AlgoRequestAny& request)
+{
+  auto& p = task->h.promise();
+
+  // Batch: only the missing rotations go to the renderer
+  if(auto* batch = std::get_if<AlgoRequestBatch>(&request))
+  {
+    pendingMode       = batch->evaluationMode;
+    pendingLod        = batch->lod;
+    pendingResolution = batch->resolutionLevel;
+    pendingBatch.assign(batch->rotations.size(), RendererResult{});
+    pendingBatchMisses.clear();
 
-  auto& request = p.algo_request.value();
-  std::visit([this](AlgoRequestBase& r) { iterationCount += !r.skipCalculation; }, request);
+    std::vector<glm::quat> misses;
+    for(size_t i = 0; i < batch->rotations.size(); ++i)
+    {
+      const glm::quat rotation = canonicalize(batch->rotations[i]);
+      float           volume;
+      if(cache.find(rotation, pendingMode, pendingLod, pendingResolution, volume))
+      {
+        pendingBatch[i] = {volume, rotation};
+        updateBestResult(pendingBatch[i], *batch);
+        continue;
+      }
+      pendingBatchMisses.push_back(i);
+      misses.push_back(rotation);
+    }
 
-  return request;
+    if(!batch->rotations.empty())
+      cameraRotation = canonicalize(batch->rotations.back());
+
+    if(misses.empty())
+    {
+      p.renderer_results = std::move(pendingBatch);
+      return true;
+    }
+    batch->rotations = std::move(misses);
+    return false;
+  }
+
+  // Absolute rotation of the request, unknown for moves before the first result
+  AlgoRequestBase          base = std::visit([](AlgoRequestBase& r) { return r; }, request);
+  std::optional<glm::quat> rotation;
+  std::visit(overloaded{
+                 [&](AlgoRequestNewQuat& r) { rotation = r.newQuat; },
+                 [&](AlgoRequestNewPos& r) { rotation = camera_math::positionToRotation(r.newPosition); },
+                 [&](AlgoRequestMoveDir& r) {
+                   if(cameraRotation)
+                     rotation = camera_math::moveRotation(*cameraRotation, r.moveDirection);
+                 },
+                 [&](AlgoRequestBatch&) {},
+             },
+             request);
+
+  if(rotation)
+    rotation = canonicalize(*rotation);
+
+  cameraRotation = rotation;
+  if(!rotation)
+  {
+    pendingStore = false;
+    return false;
+  }
+
+  float volume;
+  if(!base.skipCalculation && cache.find(*rotation, base.evaluationMode, base.lod, base.resolutionLevel, volume))
+  {
+    p.renderer_result = {volume, *rotation};
+    updateBestResult(p.renderer_result, base);
+    return true;
+  }
+
+  // Camera may not be where the algorithm expects it
+  request           = AlgoRequestNewQuat{base, *rotation};
+  pendingMode       = base.evaluationMode;
+  pendingLod        = base.lod;
+  pendingResolution = base.resolutionLevel;
+  pendingStore      = !base.skipCalculation;
+  return false;
+}
+
+void AlgorithmSync::updateBestResult(const RendererResult& result, const AlgoRequestBase& fidelity)
+{
+  if(fidelity.isFullFidelity() && (!bestResult || result.volume < bestResult->volume))
+    bestResult = result;
 }
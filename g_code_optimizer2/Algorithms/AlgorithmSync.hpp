@@ -1,5 +1,7 @@
 #pragma once
 #include "Algorithm.hpp"
+#include "EvaluationCache.hpp"
+#include "../camera_math.hpp"
 
 template <class... Ts>
 struct overloaded : Ts...
@@ -14,6 +16,11 @@ enum class AlgorithmType
   UniformPoints,
   Deterministic,
   Stochastic,
+  Cmaes,
+  Surrogate,
+  Evolution,
+  Direct,
+  MultiFidelity,
   Python
 };
 
@@ -25,17 +32,46 @@ public:
   AlgorithmSync() = default;
   ~AlgorithmSync() { stopAlgorithm(); }
 
-  AlgoRequestAny startAlgorithm(AlgorithmType algoType, unsigned int maxEvals);
+  // With a cache file, a finished run of a deterministic algorithm is stored and returned by the next start
+  // with the same algorithm, configuration and maxEvals (isAlgorithmDone right after the start)
+  AlgoRequestAny startAlgorithm(AlgorithmType algoType, unsigned int maxEvals, const EvaluationCacheSettings& cacheSettings = {});
 
   void stopAlgorithm();
 
   bool       isAlgorithmRunning() { return algorithmRunning; }
-  bool       isAlgorithmDone() { return task->h.done() || forceDone; }
-  int        getIterations() { return iterationCount; }
-  AlgoResult getAlgorithmResult() { return task->h.promise().algo_result; }
+  bool       isAlgorithmDone() { return task->h.done() || forceDone || cachedRun; }
+  int        getIterations() { return iterationCount; }  // evaluations done by the renderer (cache hits excluded)
+  AlgoResult getAlgorithmResult() { return cachedRun ? cachedRun->result : task->h.promise().algo_result; }
+
+  // Remaining gap to the global minimum (relative), only from algorithms with a lower bound
+  std::optional<float> getOptimalityGap() { return algorithm && !cachedRun ? algorithm->getOptimalityGap() : std::nullopt; }
+
+  // Best full evaluation of the full mesh in the run including cache answers, which the renderer didn't see
+  std::optional<RendererResult> getBestResult() { return bestResult; }
 
   AlgoRequestAny runAlgorithm(RendererResult result);
 
+  // Resume after AlgoRequestBatch, one result per rotation
+  AlgoRequestAny runAlgorithm(std::vector<RendererResult> results);
+
+  const EvaluationCache& getCache() const { return cache; }
+
+  // Requested rotations are replaced by the rotation with the same direction and no roll (camera_math::quatNoRoll)
+  // before evaluation and caching. The volume only depends on the direction, roll only aligns the grid,
+  // so algorithms search the sphere of directions and rotations differing in roll share one evaluation
+  // Applies to the next startAlgorithm
+  void setRollInvariant(bool enabled) { rollInvariant = enabled; }
+  bool isRollInvariant() const { return rollInvariant; }
+
+  // Lower bound of the volume for branch and bound, given to the algorithms by the next startAlgorithm
+  void setLowerBound(Algorithm::LowerBound bound) { lowerBound = std::move(bound); }
+
+  // Start points given to the algorithms by the next startAlgorithm
+  void setSeedDirections(std::vector<glm::vec3> directions) { seedDirections = std::move(directions); }
+
+  // Volume estimate for pre-filtering, given to the algorithms by the next startAlgorithm
+  void setProxy(Algorithm::Proxy estimate) { proxy = std::move(estimate); }
+
 private:
   bool                       algorithmRunning = false;
   std::optional<AlgoTask>    task;
@@ -44,4 +80,43 @@ private:
   int  maxEvals       = 0;
   int  iterationCount = 0;
   bool forceDone      = false;
+  bool rollInvariant  = false;
+
+  Algorithm::LowerBound  lowerBound;
+  std::vector<glm::vec3> seedDirections;
+  Algorithm::Proxy       proxy;
+
+  // Repeated rotations are answered without the renderer
+  // Requests sent to the renderer are absolute (AlgoRequestNewQuat) once the camera rotation is known,
+  // the camera doesn't follow the requests answered from the cache
+  EvaluationCache             cache;
+  std::optional<glm::quat>    cameraRotation;  // rotation after the last request
+  EvaluationMode              pendingMode       = EvaluationMode::Full;
+  int                         pendingLod        = 0;
+  int                         pendingResolution = 0;
+  bool                        pendingStore      = false;  // single request sent to the renderer should be cached
+  std::vector<RendererResult> pendingBatch;          // batch results, cache hits already filled
+  std::vector<size_t>         pendingBatchMisses;    // indices of pendingBatch sent to the renderer
+
+  // Persistent cache
+  std::filesystem::path                     cacheFile;
+  std::string                               runKey;     // empty for nondeterministic algorithms
+  std::optional<EvaluationCache::CachedRun> cachedRun;  // run returned from the cache
+  std::optional<RendererResult>             bestResult;
+
+  // Key of the cached runs
+  std::string makeRunKey(AlgorithmType algoType, unsigned int maxEvals, const EvaluationCacheSettings& cacheSettings) const;
+
+  // Resume the algorithm with the results stored in the promise
+  AlgoRequestAny resumeAlgorithm();
+
+  // Answers requests from the cache until one needs the renderer, returns it
+  AlgoRequestAny nextRendererRequest();
+
+  // Prepares the request for the renderer, returns true if it was answered from the cache instead
+  bool answerFromCache(AlgoRequestAny& request);
+
+  void updateBestResult(const RendererResult& result, const AlgoRequestBase& fidelity);
+
+  glm::quat canonicalize(glm::quat rotation) const { return rollInvariant ? camera_math::quatNoRoll(rotation) : rotation; }
 };
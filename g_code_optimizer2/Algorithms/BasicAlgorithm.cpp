@@ -1,17 +1,61 @@
 #include "BasicAlgorithm.hpp"
 
+#include <algorithm>
 #include <glm/gtc/constants.hpp>
 #include "FibonacciPoints.hpp"
+#include "IcospherePoints.hpp"
+#include "../camera_math.hpp"
 
 AlgoTask UniformPointsAlgorithm::algorithmLogic()
 {
-  co_await generateFibonacciPoints(*this, config.N, [this](glm::vec3 point) {
-    if(currentVolume < bestVolume)
+  setLod(config.SweepLod);
+  setResolutionLevel(config.SweepResolution);
+  int  sweepPoints = 0;
+  auto storePoint  = [this, &sweepPoints](glm::vec3 point, const RendererResult& result) {
+    sweepPoints++;
+    if(result.volume < bestVolume)
     {
-      bestVolume   = currentVolume;
-      bestRotation = currentRotation;
+      bestVolume   = result.volume;
+      bestRotation = result.rotation;
     }
-  });
+  };
+
+  // Proxy pre-filter of the Fibonacci sweep
+  FibonacciProxyFilter sweepFilter(*this, config.N,
+                                   config.Sampling == SweepSampling::Fibonacci ? config.ProxyFraction : 1.0f);
+
+  auto prunePoint = sweepFilter.combine(
+      [&](const glm::quat& rotation) { return config.BranchAndBound && canPrune(rotation, bestVolume); });
+  if(config.Sampling == SweepSampling::Icosphere)
+    co_await generateIcospherePoints(*this, config.IcosphereLevels, config.IcosphereTolerance, storePoint, prunePoint);
+  else
+    co_await generateFibonacciPoints(*this, config.N, storePoint, prunePoint);
+  if(config.BranchAndBound)
+    std::cout << "Pruned " << getPrunedCount() << " of " << sweepPoints + getPrunedCount() << " points\n";
+
+  if(sweepFilter.isActive())
+  {
+    std::cout << "[Proxy] Skipped " << sweepFilter.getSkipped() << " of " << 2 * config.N + 1 << " points\n";
+
+    // The proxy counts a face lying on the bed as overhang, the face down seeds are always evaluated
+    const size_t           seedCount = std::min<size_t>(std::max(config.FacetSeeds, 0), seedDirections.size());
+    std::vector<glm::quat> rotations;
+    for(size_t i = 0; i < seedCount; ++i)
+      rotations.push_back(camera_math::positionToRotation(seedDirections[i]));
+
+    std::vector<RendererResult> results = co_await requestVolumesForBatch(rotations);
+    for(size_t i = 0; i < results.size(); ++i)
+      storePoint(seedDirections[i], results[i]);
+  }
+
+  // Volume of the coarse mesh or grid is only an estimate
+  if(config.SweepLod != 0 || config.SweepResolution != 0)
+  {
+    setLod(0);
+    setResolutionLevel(0);
+    co_await requestVolumeForQuat(bestRotation);
+    bestVolume = currentVolume;
+  }
 
   std::cout << "Best volume is:" << bestVolume << "\n";
 
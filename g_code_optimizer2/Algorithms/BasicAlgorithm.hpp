@@ -1,5 +1,6 @@
 #pragma once
 #include "Algorithm.hpp"
+#include "IcospherePoints.hpp"
 
 #include "include/json_helpers.hpp"
 #include "include/app_config.hpp"
@@ -9,7 +10,18 @@ class UniformPointsAlgorithm : public Algorithm
   // Algo parameters
   struct Config
   {
-    int N = 10000;
+    int  N               = 10000;
+    int  SweepLod        = 0;      // level of detail of the mesh for the N points, the best one is evaluated again at 0
+    int  SweepResolution = 0;      // resolution level of the N points (halved per level), also evaluated again at 0
+    bool BranchAndBound  = false;  // skip points whose lower bound is above the best volume
+
+    // Sampling of the sweep, N is only used by fibonacci
+    SweepSampling Sampling           = SweepSampling::Fibonacci;
+    int           IcosphereLevels    = 7;      // subdivisions of the icosphere
+    float         IcosphereTolerance = 0.05f;  // split faces with a vertex within this of the best volume (relative)
+
+    float ProxyFraction = 1.0f;  // only the best fraction of the Fibonacci points by the overhang proxy is evaluated
+    int   FacetSeeds    = 8;     // face down directions of the largest facet clusters, evaluated with the proxy
   };
   const Config config;
 
@@ -22,4 +34,4 @@ public:
   }
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(UniformPointsAlgorithm::Config, N)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(UniformPointsAlgorithm::Config, N, SweepLod, SweepResolution, BranchAndBound, Sampling, IcosphereLevels, IcosphereTolerance, ProxyFraction, FacetSeeds)
@@ -0,0 +1,171 @@
+#include "CmaesAlgorithm.hpp"
+#include "../camera_math.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <numeric>
+
+namespace {
+// Search space is the 2D tangent plane
+constexpr double DIMENSION = 2;
+
+// C = B * diag(d)^2 * B^T of a symmetric 2x2 matrix, columns of B are the eigenvectors
+void eigenDecomposition(const glm::dmat2& C, glm::dmat2& B, glm::dvec2& d)
+{
+  const double a = C[0][0], b = C[1][0], c = C[1][1];
+  const double mean = 0.5 * (a + c);
+  const double diff = std::sqrt(0.25 * (a - c) * (a - c) + b * b);
+  const double l0   = std::max(mean + diff, 1e-20);
+  const double l1   = std::max(mean - diff, 1e-20);
+
+  glm::dvec2 v0 = std::abs(b) > 1e-20 ? glm::normalize(glm::dvec2(l0 - c, b)) : (a >= c ? glm::dvec2(1, 0) : glm::dvec2(0, 1));
+  B             = glm::dmat2(v0, glm::dvec2(-v0.y, v0.x));
+  d             = {std::sqrt(l0), std::sqrt(l1)};
+}
+}  // namespace
+
+CmaesAlgorithm::Parameters CmaesAlgorithm::makeParameters(int lambda)
+{
+  const double n = DIMENSION;
+
+  Parameters p;
+  p.lambda = lambda;
+  p.mu     = lambda / 2;
+  for(int i = 0; i < p.mu; ++i)
+    p.weights.push_back(std::log(p.mu + 0.5) - std::log(i + 1.0));
+
+  const double sum = std::accumulate(p.weights.begin(), p.weights.end(), 0.0);
+  double       sq  = 0;
+  for(double& w : p.weights)
+  {
+    w /= sum;
+    sq += w * w;
+  }
+  p.mueff = 1.0 / sq;
+
+  p.cc    = (4 + p.mueff / n) / (n + 4 + 2 * p.mueff / n);
+  p.cs    = (p.mueff + 2) / (n + p.mueff + 5);
+  p.c1    = 2 / ((n + 1.3) * (n + 1.3) + p.mueff);
+  p.cmu   = std::min(1 - p.c1, 2 * (p.mueff - 2 + 1 / p.mueff) / ((n + 2) * (n + 2) + p.mueff));
+  p.damps = 1 + 2 * std::max(0.0, std::sqrt((p.mueff - 1) / (n + 1)) - 1) + p.cs;
+  return p;
+}
+
+AlgoTask CmaesAlgorithm::runCmaes(glm::dvec3 start, int lambda, int run)
+{
+  const Parameters p    = makeParameters(lambda);
+  const double     n    = DIMENSION;
+  const double     chiN = std::sqrt(n) * (1 - 1 / (4 * n) + 1 / (21 * n * n));
+
+  TangentPlane plane(start);
+  double       sigma = config.SigmaStart;
+  glm::dmat2   C(1.0);
+  glm::dvec2   pc{0, 0};
+  glm::dvec2   ps{0, 0};
+
+  std::normal_distribution<double> normal(0.0, 1.0);
+  std::deque<float>                generationBest;  // best volume of the recent generations
+
+  int generation = 0;
+  for(; generation < config.MaxGenerations; ++generation)
+  {
+    glm::dmat2 B;
+    glm::dvec2 d;
+    eigenDecomposition(C, B, d);
+
+    if(sigma * std::max(d.x, d.y) < config.SigmaEnd)
+      break;
+
+    // Sample and evaluate the population, the mean is the center of the plane
+    std::vector<glm::dvec2> steps(p.lambda);
+    std::vector<glm::quat>  rotations(p.lambda);
+    for(int k = 0; k < p.lambda; ++k)
+    {
+      glm::dvec2 z{normal(gen), normal(gen)};
+      steps[k]     = B * (d * z);
+      rotations[k] = camera_math::positionToRotation(glm::vec3(plane.toSphere(sigma * steps[k])));
+    }
+
+    std::vector<RendererResult> results = co_await requestVolumesForBatch(rotations);
+
+    std::vector<int> order(p.lambda);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int i, int j) { return results[i].volume < results[j].volume; });
+
+    if(results[order[0]].volume < bestVolume)
+    {
+      bestVolume   = results[order[0]].volume;
+      bestRotation = results[order[0]].rotation;
+    }
+
+    // Weighted mean of the best mu steps
+    glm::dvec2 meanStep{0, 0};
+    for(int i = 0; i < p.mu; ++i)
+      meanStep += p.weights[i] * steps[order[i]];
+    const glm::dvec3 newMean = plane.toSphere(sigma * meanStep);
+
+    // Evolution paths, C^-1/2 * meanStep = B * diag(1/d) * B^T * meanStep
+    const glm::dvec2 whitened = B * ((glm::transpose(B) * meanStep) / d);
+    ps = (1 - p.cs) * ps + std::sqrt(p.cs * (2 - p.cs) * p.mueff) * whitened;
+
+    const double psNorm = glm::length(ps);
+    const bool hsig = psNorm / std::sqrt(1 - std::pow(1 - p.cs, 2.0 * (generation + 1))) < (1.4 + 2 / (n + 1)) * chiN;
+    pc = (1 - p.cc) * pc + (hsig ? std::sqrt(p.cc * (2 - p.cc) * p.mueff) : 0.0) * meanStep;
+
+    // Covariance: rank-one and rank-mu updates
+    glm::dmat2 rankMu(0.0);
+    for(int i = 0; i < p.mu; ++i)
+      rankMu += p.weights[i] * glm::outerProduct(steps[order[i]], steps[order[i]]);
+    C = (1 - p.c1 - p.cmu) * C + p.c1 * (glm::outerProduct(pc, pc) + (hsig ? 0.0 : p.cc * (2 - p.cc)) * C) + p.cmu * rankMu;
+
+    // Step size, more than half of the sphere is never needed
+    sigma = std::min(sigma * std::exp((p.cs / p.damps) * (psNorm / chiN - 1)), glm::pi<double>());
+
+    // Paths and covariance stay in the carried basis
+    plane.moveCenter(newMean);
+
+    // Flat progress over the last generations
+    generationBest.push_back(results[order[0]].volume);
+    const size_t history = 10 + (size_t)std::ceil(30 * n / p.lambda);
+    if(generationBest.size() > history)
+      generationBest.pop_front();
+    if(generationBest.size() == history)
+    {
+      auto [low, high] = std::minmax_element(generationBest.begin(), generationBest.end());
+      if(*high - *low <= config.VolumeTolerance * std::abs(*low))
+        break;
+    }
+  }
+
+  std::cout << "[CMA-ES] Run " << run << ": population " << p.lambda << ", " << generation
+            << " generations, best volume " << bestVolume << "\n";
+  co_return {};
+}
+
+AlgoTask CmaesAlgorithm::algorithmLogic()
+{
+  std::uniform_real_distribution<double> angle(0.0, glm::two_pi<double>());
+  std::uniform_real_distribution<double> height(-1.0, 1.0);
+
+  const int defaultLambda = 4 + (int)std::floor(3 * std::log(DIMENSION));
+  double    lambda        = config.PopulationSize > 0 ? config.PopulationSize : defaultLambda;
+
+  for(int run = 0; run <= config.Restarts; ++run)
+  {
+    // Uniform random start
+    const double z = height(gen);
+    const double r = std::sqrt(1 - z * z);
+    const double t = angle(gen);
+    co_await runCmaes({r * std::cos(t), r * std::sin(t), z}, (int)std::round(lambda), run);
+
+    lambda *= config.PopulationGrowth;
+  }
+
+  std::cout << "Best volume is:" << bestVolume << "\n";
+
+  // Finish
+  co_return AlgoResult(bestVolume, bestRotation);
+}
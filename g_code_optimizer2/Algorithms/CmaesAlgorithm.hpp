@@ -0,0 +1,56 @@
+#pragma once
+#include "Algorithm.hpp"
+#include "TangentPlane.hpp"
+
+#include "include/json_helpers.hpp"
+#include "include/app_config.hpp"
+
+#include <random>
+
+// CMA-ES (Hansen) in the tangent plane of the sphere of camera positions
+// 1) sample a population around the mean, evaluate it as one batch
+// 2) move the mean, adapt step size and covariance
+// 3) recenter the plane at the new mean (the mean is always the origin of the plane)
+// Restarts from random points with growing population (IPOP), best of all runs is the result
+class CmaesAlgorithm : public Algorithm
+{
+  struct Config
+  {
+    int    PopulationSize   = 0;       // 0: default 4 + 3 ln(2) = 6
+    int    Restarts         = 4;       // runs after the first one
+    double PopulationGrowth = 2;       // population multiplier of each restart
+    double SigmaStart       = 0.5;     // initial step size (radians)
+    double SigmaEnd         = 0.0001;  // end a run when the largest step is below (radians)
+    double VolumeTolerance  = 1e-6;    // end a run when the volumes of the last generations differ less (relative)
+    int    MaxGenerations   = 200;     // per run
+    int    Seed             = 1;
+  };
+  const Config config;
+
+  // Strategy parameters depending on the population size
+  struct Parameters
+  {
+    int                 lambda;
+    int                 mu;
+    std::vector<double> weights;
+    double              mueff;
+    double              cc, cs, c1, cmu, damps;
+  };
+  static Parameters makeParameters(int lambda);
+
+  std::mt19937 gen;
+
+  // Runs one CMA-ES from the start direction, improves bestVolume/bestRotation
+  AlgoTask runCmaes(glm::dvec3 start, int lambda, int run);
+
+public:
+  AlgoTask algorithmLogic() override;
+  CmaesAlgorithm()
+      : Algorithm()
+      , config(getJsonConfig<Config>(AppConfig::instance().getAlgorithmsPath() / "cmaes.json"))
+      , gen(config.Seed)
+  {
+  }
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(CmaesAlgorithm::Config, PopulationSize, Restarts, PopulationGrowth, SigmaStart, SigmaEnd, VolumeTolerance, MaxGenerations, Seed)
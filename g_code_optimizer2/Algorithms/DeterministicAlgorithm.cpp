@@ -2,7 +2,10 @@
 
 #include <glm/gtc/constants.hpp>
 #include "HookeJeeves.hpp"
+#include "MultiStartHookeJeeves.hpp"
 #include "FibonacciPoints.hpp"
+#include "IcospherePoints.hpp"
+#include "../camera_math.hpp"
 
 #include <fstream>
 
@@ -10,30 +13,83 @@ AlgoTask DeterministicAlgorithm::algorithmLogic()
 {
   // Step: 1 find best K candidates
   std::cout << "Finding best K candidates...\n";
-  co_await generateFibonacciPoints(*this, config.N, [this](glm::vec3 point) {
+  setEvaluationMode(config.SweepEvaluation);
+  setLod(config.SweepLod);
+  setResolutionLevel(config.SweepResolution);
+
+  // Seeds are evaluated first, they are likely good and always get a local search
+  std::vector<PointWithInfo> seedPoints;
+  const size_t               seedCount = std::min<size_t>(std::max(config.FacetSeeds, 0), seedDirections.size());
+  if(seedCount > 0)
+  {
+    std::vector<glm::quat> rotations;
+    for(size_t i = 0; i < seedCount; ++i)
+      rotations.push_back(camera_math::positionToRotation(seedDirections[i]));
+
+    std::vector<RendererResult> results = co_await requestVolumesForBatch(rotations);
+    for(const auto& result : results)
+      seedPoints.push_back({result.volume, result.rotation});
+  }
+
+  int  sweepPoints = 0;
+  auto storePoint  = [this, &sweepPoints](glm::vec3 point, const RendererResult& result) {
+    sweepPoints++;
     if(bestKPoints.size() < config.K)
     {
-      bestKPoints.push({currentVolume, currentRotation});
+      bestKPoints.push({result.volume, result.rotation});
     }
-    else if(currentVolume < bestKPoints.top().volume)
+    else if(result.volume < bestKPoints.top().volume)
     {
       bestKPoints.pop();
-      bestKPoints.push({currentVolume, currentRotation});
+      bestKPoints.push({result.volume, result.rotation});
     }
+  };
+
+  // Proxy pre-filter of the Fibonacci sweep
+  FibonacciProxyFilter sweepFilter(*this, config.N,
+                                   config.Sampling == SweepSampling::Fibonacci ? config.ProxyFraction : 1.0f);
+
+  auto prunePoint = sweepFilter.combine([&](const glm::quat& rotation) {
+    // Can't enter the best K
+    return config.BranchAndBound && (int)bestKPoints.size() >= config.K && canPrune(rotation, bestKPoints.top().volume);
   });
+  if(config.Sampling == SweepSampling::Icosphere)
+    co_await generateIcospherePoints(*this, config.IcosphereLevels, config.IcosphereTolerance, storePoint, prunePoint);
+  else
+    co_await generateFibonacciPoints(*this, config.N, storePoint, prunePoint);
+  setEvaluationMode(EvaluationMode::Full);
+  setLod(0);
+  setResolutionLevel(0);
+  if(config.BranchAndBound)
+    std::cout << "Pruned " << getPrunedCount() << " of " << sweepPoints + getPrunedCount() << " points\n";
+  if(sweepFilter.isActive())
+    std::cout << "[Proxy] Skipped " << sweepFilter.getSkipped() << " of " << 2 * config.N + 1 << " points\n";
+
+  for(const auto& point : seedPoints)
+    bestKPoints.push(point);
+
+  // Volumes of the sweep are only estimates when it didn't use the full evaluation of the full mesh
+  const bool reevaluate = config.SweepEvaluation != EvaluationMode::Full || config.SweepLod != 0
+                          || config.SweepResolution != 0;
 
   // Optimize best k
   std::cout << "Optimizing best K candidates...\n";
+  if(config.ConcurrentStarts)
+    co_await optimizeBestKConcurrently(reevaluate);
+
   while(!bestKPoints.empty())
   {
     PointWithInfo point = bestKPoints.top();
     bestKPoints.pop();
 
     // Set position to the point
-    co_await requestVolumeForQuat(point.rotation, true);
+    co_await requestVolumeForQuat(point.rotation, !reevaluate);
 
-    currentVolume   = point.volume;
-    currentRotation = point.rotation;
+    if(!reevaluate)
+    {
+      currentVolume   = point.volume;
+      currentRotation = point.rotation;
+    }
 
     // Run local optimizer
     HookeJeeves localOptimizer = HookeJeeves(*this, config.KPointsDeltaStart, config.KPointsDeltaEnd, config.KPointsMaxSteps);
@@ -66,3 +122,34 @@ AlgoTask DeterministicAlgorithm::algorithmLogic()
   // Finish
   co_return AlgoResult(bestVolume, bestRotation);
 }
+
+AlgoTask DeterministicAlgorithm::optimizeBestKConcurrently(bool reevaluate)
+{
+  // Same start order as the sequential loop, ties of the best point go to the same search
+  std::vector<PointWithInfo> points;
+  while(!bestKPoints.empty())
+  {
+    points.push_back(bestKPoints.top());
+    bestKPoints.pop();
+  }
+
+  if(reevaluate)
+  {
+    std::vector<glm::quat> rotations;
+    for(const auto& point : points)
+      rotations.push_back(point.rotation);
+
+    std::vector<RendererResult> results = co_await requestVolumesForBatch(rotations);
+    for(size_t i = 0; i < results.size(); ++i)
+      points[i] = {results[i].volume, results[i].rotation};
+  }
+
+  MultiStartHookeJeeves localOptimizer(*this, config.KPointsDeltaStart, config.KPointsDeltaEnd, config.KPointsMaxSteps);
+  for(const auto& point : points)
+    localOptimizer.addStart(point.rotation, point.volume);
+  co_await localOptimizer.optimize();
+
+  if(localOptimizer.getBestVolume() < bestPoint.volume)
+    bestPoint = {localOptimizer.getBestVolume(), localOptimizer.getBestRotation()};
+  co_return {};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Algorithm.hpp"
+#include "IcospherePoints.hpp"
 
 #include <queue>
 
@@ -15,13 +16,26 @@ class DeterministicAlgorithm : public Algorithm
   struct Config
   {
     // Algo parameters
-    int N = 2000;  // N points to generate
-    int K = 10;    // K points to choose
+    int            N               = 2000;                  // N points to generate
+    int            K               = 10;                    // K points to choose
+    EvaluationMode SweepEvaluation = EvaluationMode::Full;  // evaluation of the N points
+    int            SweepLod        = 0;                     // level of detail of the mesh for the N points
+    int            SweepResolution = 0;                     // resolution level of the N points (halved per level)
+    bool           BranchAndBound  = false;                 // skip points whose lower bound is above the K-th best
+
+    // Sampling of the sweep, N is only used by fibonacci
+    SweepSampling Sampling           = SweepSampling::Fibonacci;
+    int           IcosphereLevels    = 6;     // subdivisions of the icosphere
+    float         IcosphereTolerance = 0.1f;  // split faces with a vertex within this of the best volume (relative)
+
+    int   FacetSeeds    = 0;     // face down directions of the largest facet clusters, optimized with the best K points
+    float ProxyFraction = 1.0f;  // only the best fraction of the Fibonacci points by the overhang proxy is evaluated
 
     // Parameters for local optimization of K points
     float KPointsDeltaStart = 0.1f;
     float KPointsDeltaEnd   = 0.03f;
     int   KPointsMaxSteps   = 100;
+    bool  ConcurrentStarts  = true;  // interleave the K searches, their requests are evaluated as one batch per step
 
     // Parameters for local optimization of last point
     float LastPointDeltaStart = 0.03f;
@@ -42,6 +56,9 @@ class DeterministicAlgorithm : public Algorithm
   std::priority_queue<PointWithInfo> bestKPoints;
   PointWithInfo                      bestPoint{std::numeric_limits<float>::max(), glm::quat(1, 0, 0, 0)};
 
+  // Local optimization of all best K points at once
+  AlgoTask optimizeBestKConcurrently(bool reevaluate);
+
 public:
   AlgoTask algorithmLogic() override;
   DeterministicAlgorithm()
@@ -51,4 +68,6 @@ public:
   }
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(DeterministicAlgorithm::Config, N, K, KPointsDeltaStart, KPointsDeltaEnd, KPointsMaxSteps, LastPointDeltaStart, LastPointDeltaEnd, LastPointMaxSteps)
+NLOHMANN_JSON_SERIALIZE_ENUM(EvaluationMode, {{EvaluationMode::Full, "full"}, {EvaluationMode::Analytic, "analytic"}})
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(DeterministicAlgorithm::Config, N, K, SweepEvaluation, SweepLod, SweepResolution, BranchAndBound, Sampling, IcosphereLevels, IcosphereTolerance, FacetSeeds, ProxyFraction, KPointsDeltaStart, KPointsDeltaEnd, KPointsMaxSteps, ConcurrentStarts, LastPointDeltaStart, LastPointDeltaEnd, LastPointMaxSteps)
@@ -0,0 +1,198 @@
+#include "DirectAlgorithm.hpp"
+#include "../camera_math.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+glm::vec3 DirectAlgorithm::toSphere(int face, glm::vec2 uv)
+{
+  const int axis = face / 2;
+  glm::vec3 p;
+  p[axis]           = face % 2 == 0 ? 1.0f : -1.0f;
+  p[(axis + 1) % 3] = uv.x;
+  p[(axis + 2) % 3] = uv.y;
+  return glm::normalize(p);
+}
+
+float DirectAlgorithm::cellRadius(int face, glm::vec2 center, float halfSize)
+{
+  const glm::vec3 c      = toSphere(face, center);
+  float           minCos = 1;
+  for(glm::vec2 corner : {glm::vec2(-1, -1), glm::vec2(-1, 1), glm::vec2(1, -1), glm::vec2(1, 1)})
+    minCos = std::min(minCos, glm::dot(c, toSphere(face, center + halfSize * corner)));
+  return std::acos(std::clamp(minCos, -1.0f, 1.0f));
+}
+
+float DirectAlgorithm::lowerBound() const
+{
+  float bound = std::numeric_limits<float>::max();
+  for(const Cell& cell : cells)
+    bound = std::min(bound, cell.volume - lipschitz * cell.radius);
+  return bound;
+}
+
+std::vector<size_t> DirectAlgorithm::selectCells() const
+{
+  // Divisible cells by radius, ties by volume
+  std::vector<size_t> order;
+  for(size_t i = 0; i < cells.size(); ++i)
+  {
+    // Known constant: the cell can't contain a better volume
+    if(cells[i].level >= config.MaxLevel
+       || (config.Lipschitz > 0 && cells[i].volume - lipschitz * cells[i].radius >= bestVolume))
+      continue;
+    order.push_back(i);
+  }
+  if(order.empty())
+    return {};
+
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return cells[a].radius != cells[b].radius ? cells[a].radius < cells[b].radius : cells[a].volume < cells[b].volume;
+  });
+
+  // Lower right convex hull from the smallest volume (largest radius on ties) to the largest radius
+  size_t start = 0;
+  for(size_t i = 1; i < order.size(); ++i)
+    if(cells[order[i]].volume <= cells[order[start]].volume)
+      start = i;
+
+  auto cross = [&](size_t o, size_t a, size_t b) {
+    const Cell &co = cells[o], &ca = cells[a], &cb = cells[b];
+    return (ca.radius - co.radius) * (cb.volume - co.volume) - (ca.volume - co.volume) * (cb.radius - co.radius);
+  };
+
+  std::vector<size_t> hull;
+  for(size_t i = start; i < order.size(); ++i)
+  {
+    const size_t cell = order[i];
+    if(!hull.empty() && cells[hull.back()].radius == cells[cell].radius)
+      continue;  // same radius with a larger volume
+    while(hull.size() >= 2 && cross(hull[hull.size() - 2], hull.back(), cell) <= 0)
+      hull.pop_back();
+    hull.push_back(cell);
+  }
+
+  // Cells that could improve the best volume by more than epsilon with the largest slope they are optimal for
+  const float         fmin = cells[hull.front()].volume;
+  std::vector<size_t> selected;
+  for(size_t k = 0; k < hull.size(); ++k)
+  {
+    const Cell& cell = cells[hull[k]];
+    if(k + 1 < hull.size())
+    {
+      const Cell& next  = cells[hull[k + 1]];
+      const float slope = (next.volume - cell.volume) / (next.radius - cell.radius);
+      if(cell.volume - slope * cell.radius > fmin - config.Epsilon * std::abs(fmin))
+        continue;
+    }
+    selected.push_back(hull[k]);
+  }
+  return selected;
+}
+
+AlgoTask DirectAlgorithm::algorithmLogic()
+{
+  lipschitz = config.Lipschitz;
+
+  // Faces of the cube
+  std::vector<glm::quat> rotations;
+  for(int face = 0; face < 6; ++face)
+  {
+    cells.push_back({face, {0, 0}, 0, cellRadius(face, {0, 0}, 1), 0});
+    rotations.push_back(camera_math::positionToRotation(toSphere(face, {0, 0})));
+  }
+
+  int evaluations = 0;
+  auto store      = [&](Cell& cell, const RendererResult& result) {
+    cell.volume = result.volume;
+    evaluations++;
+    if(result.volume < bestVolume)
+    {
+      bestVolume   = result.volume;
+      bestRotation = result.rotation;
+    }
+  };
+
+  std::vector<RendererResult> results = co_await requestVolumesForBatch(rotations);
+  for(int face = 0; face < 6; ++face)
+    store(cells[face], results[face]);
+
+  // Only a known constant gives a bound, the gap of an estimated one is not reported as the optimality gap
+  const bool           certified = config.Lipschitz > 0;
+  std::optional<float> gap;
+  float                estimated = 0;  // largest slope between a parent and its children
+  while(true)
+  {
+    if(!certified)
+      lipschitz = config.LipschitzFactor * estimated;
+
+    // Estimated constant is unknown until the first division
+    if(certified || estimated > 0)
+    {
+      gap = (bestVolume - lowerBound()) / std::abs(bestVolume);
+      if(certified)
+        optimalityGap = gap;
+      if(*gap <= config.GapTolerance)
+        break;
+    }
+    if(evaluations >= config.MaxEvaluations)
+      break;
+
+    // Cells are ordered by radius, the largest ones (global exploration) are kept when the evaluations run out
+    std::vector<size_t> selected = selectCells();
+    const size_t        limit    = (size_t)std::max(1, (config.MaxEvaluations - evaluations) / 8);
+    if(selected.size() > limit)
+      selected.erase(selected.begin(), selected.end() - (std::ptrdiff_t)limit);
+    if(selected.empty())
+      break;
+
+    // Divide, the middle child keeps the cell (and its evaluation)
+    std::vector<Cell>   children;
+    std::vector<size_t> parents;
+    rotations.clear();
+    for(size_t index : selected)
+    {
+      Cell&       cell = cells[index];
+      const float step = 2.0f * std::pow(3.0f, -float(cell.level + 1));
+      cell.level++;
+      cell.radius = cellRadius(cell.face, cell.center, 0.5f * step);
+
+      for(int i = -1; i <= 1; ++i)
+      {
+        for(int j = -1; j <= 1; ++j)
+        {
+          if(i == 0 && j == 0)
+            continue;
+          const glm::vec2 center = cell.center + step * glm::vec2(i, j);
+          children.push_back({cell.face, center, cell.level, cellRadius(cell.face, center, 0.5f * step), 0});
+          parents.push_back(index);
+          rotations.push_back(camera_math::positionToRotation(toSphere(cell.face, center)));
+        }
+      }
+    }
+
+    results = co_await requestVolumesForBatch(rotations);
+    for(size_t i = 0; i < children.size(); ++i)
+    {
+      store(children[i], results[i]);
+
+      const Cell&     parent = cells[parents[i]];
+      const glm::vec3 a      = toSphere(parent.face, parent.center);
+      const glm::vec3 b      = toSphere(children[i].face, children[i].center);
+      const float     angle  = std::acos(std::clamp(glm::dot(a, b), -1.0f, 1.0f));
+      if(angle > 0)
+        estimated = std::max(estimated, std::abs(children[i].volume - parent.volume) / angle);
+    }
+    cells.insert(cells.end(), children.begin(), children.end());
+
+    std::cout << "[DIRECT] " << evaluations << " evaluations, " << selected.size() << " cells divided, best volume "
+              << bestVolume << ", gap " << 100 * gap.value_or(1) << "%\n";
+  }
+
+  std::cout << "[DIRECT] Gap " << 100 * gap.value_or(1) << "% (" << (certified ? "bound" : "estimate")
+            << ", L = " << lipschitz << ")\n";
+  std::cout << "Best volume is:" << bestVolume << "\n";
+
+  // Finish
+  co_return AlgoResult(bestVolume, bestRotation);
+}
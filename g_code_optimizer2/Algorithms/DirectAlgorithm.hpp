@@ -0,0 +1,59 @@
+#pragma once
+#include "Algorithm.hpp"
+
+#include "include/json_helpers.hpp"
+#include "include/app_config.hpp"
+
+// DIRECT (dividing rectangles, Jones) on a cube map of the sphere of camera positions
+// Every face of the cube is a square cell, a divided cell is split into 3x3 children (the middle one keeps the center)
+// 1) select the potentially optimal cells (lower right convex hull of cell radius and center volume)
+// 2) divide them, evaluate all new centers as one batch
+// 3) repeat until the optimality gap is below tolerance
+//
+// Gap is the best volume minus the lower bound min(volume - L * radius) over all cells, radius is the angle from the
+// center to the farthest corner. With a known Lipschitz constant L the bound holds, without it L is estimated from
+// the divided cells and the gap is only an estimate (used to stop, not reported as the optimality gap).
+// Cells whose bound is above the best volume are never divided.
+class DirectAlgorithm : public Algorithm
+{
+  struct Config
+  {
+    float Lipschitz       = 0;        // volume per radian, 0: estimated
+    float LipschitzFactor = 1.5f;     // safety factor of the estimated constant
+    float Epsilon         = 0.0001f;  // min relative improvement a potentially optimal cell must be able to give
+    float GapTolerance    = 0.001f;   // end when the gap is below (relative to the best volume)
+    int   MaxLevel        = 10;       // cells of this level are not divided
+    int   MaxEvaluations  = 5000;
+  };
+  const Config config;
+
+  struct Cell
+  {
+    int       face;
+    glm::vec2 center;  // [-1, 1] on the face
+    int       level;   // half size is 3^-level
+    float     radius;  // radians
+    float     volume;
+  };
+
+  std::vector<Cell> cells;  // leaves
+  float             lipschitz = 0;
+
+  static glm::vec3 toSphere(int face, glm::vec2 uv);
+  static float     cellRadius(int face, glm::vec2 center, float halfSize);
+
+  // Indices of the potentially optimal cells
+  std::vector<size_t> selectCells() const;
+
+  float lowerBound() const;
+
+public:
+  AlgoTask algorithmLogic() override;
+  DirectAlgorithm()
+      : Algorithm()
+      , config(getJsonConfig<Config>(AppConfig::instance().getAlgorithmsPath() / "direct.json"))
+  {
+  }
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(DirectAlgorithm::Config, Lipschitz, LipschitzFactor, Epsilon, GapTolerance, MaxLevel, MaxEvaluations)
@@ -0,0 +1,143 @@
+#include "EvaluationCache.hpp"
+#include "../camera_math.hpp"
+
+#include "include/hash_helpers.hpp"
+
+#include <cmath>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+void EvaluationCache::reset(float tolerance)
+{
+  this->tolerance = tolerance;
+  volumes.clear();
+  entries.clear();
+  runs.clear();
+  lookups = 0;
+  hits    = 0;
+}
+
+bool EvaluationCache::find(glm::quat rotation, EvaluationMode mode, int lod, int resolutionLevel, float& volume)
+{
+  if(!isEnabled())
+    return false;
+
+  lookups++;
+  auto it = volumes.find(makeKey(rotation, mode, lod, resolutionLevel));
+  if(it == volumes.end())
+    return false;
+
+  hits++;
+  volume = it->second;
+  return true;
+}
+
+void EvaluationCache::store(glm::quat rotation, EvaluationMode mode, int lod, int resolutionLevel, float volume)
+{
+  if(!isEnabled())
+    return;
+
+  // First result of a cell is kept
+  if(volumes.try_emplace(makeKey(rotation, mode, lod, resolutionLevel), volume).second)
+    entries.push_back({rotation, mode, lod, resolutionLevel, volume});
+}
+
+const EvaluationCache::CachedRun* EvaluationCache::findRun(const std::string& key) const
+{
+  auto it = runs.find(key);
+  return it != runs.end() ? &it->second : nullptr;
+}
+
+void EvaluationCache::storeRun(const std::string& key, const CachedRun& run)
+{
+  if(isEnabled())
+    runs[key] = run;
+}
+
+// File layout:
+// {
+//   "entries": [[x, y, z, w, mode, volume, lod, resolution level], ...],  (lod and level are optional, 0 when missing)
+//   "runs": {"key": [result volume, x, y, z, w, best volume, x, y, z, w, iterations], ...}  (iterations are optional)
+// }
+void EvaluationCache::load(const std::filesystem::path& path)
+{
+  if(!isEnabled() || !std::filesystem::exists(path))
+    return;
+
+  std::ifstream in(path);
+  if(!in.is_open())
+    throw std::runtime_error("Cannot open file for reading: " + path.string());
+
+  try
+  {
+    nlohmann::json doc = nlohmann::json::parse(in);
+    for(const auto& e : doc.at("entries"))
+      store(glm::quat(e[3].get<float>(), e[0].get<float>(), e[1].get<float>(), e[2].get<float>()),
+            (EvaluationMode)e[4].get<int>(), e.size() > 6 ? e[6].get<int>() : 0, e.size() > 7 ? e[7].get<int>() : 0,
+            e[5].get<float>());
+
+    for(const auto& [key, r] : doc.at("runs").items())
+    {
+      CachedRun run;
+      run.result = {r[0].get<float>(), glm::quat(r[4].get<float>(), r[1].get<float>(), r[2].get<float>(), r[3].get<float>())};
+      run.best       = {r[5].get<float>(), glm::quat(r[9].get<float>(), r[6].get<float>(), r[7].get<float>(), r[8].get<float>())};
+      run.iterations = r.size() > 10 ? r[10].get<int>() : -1;
+      runs[key]      = run;
+    }
+  }
+  catch(const nlohmann::json::exception&)
+  {
+    throw std::runtime_error("Failed to parse " + path.string());
+  }
+
+  std::cout << "Loaded " << entries.size() << " cached evaluations from " << path.string() << "\n";
+}
+
+void EvaluationCache::save(const std::filesystem::path& path) const
+{
+  if(!isEnabled())
+    return;
+
+  nlohmann::json doc;
+  doc["entries"] = nlohmann::json::array();
+  for(const Entry& e : entries)
+    doc["entries"].push_back({e.rotation.x, e.rotation.y, e.rotation.z, e.rotation.w, (int)e.mode, e.volume, e.lod,
+                              e.resolutionLevel});
+
+  doc["runs"] = nlohmann::json::object();
+  for(const auto& [key, run] : runs)
+  {
+    const glm::quat& r = run.result.bestRotation;
+    const glm::quat& b = run.best.rotation;
+    doc["runs"][key]   = {run.result.bestVolume, r.x, r.y, r.z, r.w, run.best.volume, b.x, b.y, b.z, b.w, run.iterations};
+  }
+
+  if(path.has_parent_path())
+    std::filesystem::create_directories(path.parent_path());
+
+  std::ofstream out(path);
+  if(!out.is_open())
+    throw std::runtime_error("Cannot open file for writing: " + path.string());
+  out << doc.dump() << '\n';
+}
+
+EvaluationCache::Key EvaluationCache::makeKey(glm::quat rotation, EvaluationMode mode, int lod, int resolutionLevel) const
+{
+  glm::vec3 forward = glm::normalize(rotation * camera_math::defaultForward);
+
+  Key key;
+  for(int i = 0; i < 3; ++i)
+    key.forward[i] = (int32_t)std::lround(forward[i] / tolerance);
+  key.roll = (int32_t)std::lround(camera_math::roll(rotation) / tolerance);
+  key.mode            = mode;
+  key.lod             = lod;
+  key.resolutionLevel = resolutionLevel;
+  return key;
+}
+
+size_t EvaluationCache::KeyHash::operator()(const Key& key) const
+{
+  const int32_t values[] = {key.forward[0], key.forward[1], key.forward[2], key.roll, (int32_t)key.mode, key.lod, key.resolutionLevel};
+  return (size_t)hashBytes(values, sizeof(values));
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "Algorithm.hpp"
+
+#include <filesystem>
+#include <unordered_map>
+
+struct EvaluationCacheSettings
+{
+  float                 tolerance = 0;  // quantization (radians), 0 disables the cache
+  std::filesystem::path file;           // persistent cache, empty keeps it in memory only
+  std::string           runSettings;    // inputs outside the algorithm configs that change a run, part of the run key
+};
+
+// Volumes of already evaluated rotations
+// Rotations are quantized by build direction (forward vector) and roll, both with the same tolerance,
+// rotations in the same cell share one result
+//
+// Every evaluation is also kept with its exact rotation, so a saved file can be loaded with any tolerance
+class EvaluationCache
+{
+public:
+  // Run of a deterministic algorithm, repeated runs with the same key return it without evaluating
+  struct CachedRun
+  {
+    AlgoResult     result;
+    RendererResult best;             // best full evaluation seen by the run
+    int            iterations = -1;  // evaluations done by the renderer, -1 for runs saved without it
+  };
+
+  // tolerance = 0 disables the cache, clears all entries
+  void reset(float tolerance);
+  bool isEnabled() const { return tolerance > 0; }
+
+  // Counts lookups and hits
+  // Evaluations of different modes, levels of detail or resolution levels are kept apart
+  bool find(glm::quat rotation, EvaluationMode mode, int lod, int resolutionLevel, float& volume);
+  void store(glm::quat rotation, EvaluationMode mode, int lod, int resolutionLevel, float volume);
+
+  const CachedRun* findRun(const std::string& key) const;
+  void             storeRun(const std::string& key, const CachedRun& run);
+
+  // Missing file is an empty cache, throws if the file can't be parsed/written
+  void load(const std::filesystem::path& path);
+  void save(const std::filesystem::path& path) const;
+
+  uint64_t getLookups() const { return lookups; }
+  uint64_t getHits() const { return hits; }
+  float    getHitRate() const { return lookups > 0 ? float(hits) / float(lookups) : 0.0f; }
+
+private:
+  struct Key
+  {
+    int32_t        forward[3];
+    int32_t        roll;
+    EvaluationMode mode;
+    int32_t        lod;
+    int32_t        resolutionLevel;
+
+    bool operator==(const Key& other) const = default;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry
+  {
+    glm::quat      rotation;
+    EvaluationMode mode;
+    int            lod;
+    int            resolutionLevel;
+    float          volume;
+  };
+
+  float                                      tolerance = 0;
+  std::unordered_map<Key, float, KeyHash>    volumes;
+  std::vector<Entry>                         entries;  // all stored evaluations, saved to the file
+  std::unordered_map<std::string, CachedRun> runs;
+  uint64_t                                   lookups = 0;
+  uint64_t                                   hits    = 0;
+
+  Key makeKey(glm::quat rotation, EvaluationMode mode, int lod, int resolutionLevel) const;
+};
@@ -0,0 +1,112 @@
+#include "EvolutionAlgorithm.hpp"
+#include "../camera_math.hpp"
+#include "HookeJeeves.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+AlgoTask EvolutionAlgorithm::algorithmLogic()
+{
+  const int populationSize = std::max(config.PopulationSize, 4);
+
+  std::normal_distribution<float>       normal(0.0f, 1.0f);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  std::uniform_int_distribution<int>    member(0, populationSize - 1);
+  std::uniform_int_distribution<int>    coordinate(0, 2);
+
+  auto evaluate = [this](const std::vector<glm::vec3>& points) {
+    std::vector<glm::quat> rotations;
+    for(const glm::vec3& point : points)
+      rotations.push_back(camera_math::positionToRotation(point));
+    return requestVolumesForBatch(rotations);
+  };
+
+  // Uniform random start
+  std::vector<glm::vec3> population(populationSize);
+  for(glm::vec3& point : population)
+  {
+    do
+      point = {normal(gen), normal(gen), normal(gen)};
+    while(glm::length(point) < 1e-6f);
+    point = glm::normalize(point);
+  }
+
+  std::vector<RendererResult> results = co_await evaluate(population);
+
+  auto bestIndex = [&]() {
+    return int(std::min_element(results.begin(), results.end(), [](const auto& a, const auto& b) { return a.volume < b.volume; })
+               - results.begin());
+  };
+
+  int best              = bestIndex();
+  int timeSinceLastBest = 0;
+  int generation        = 0;
+  for(; generation < config.MaxGenerations; ++generation)
+  {
+    // Trial points of the generation
+    std::vector<glm::vec3> trials(populationSize);
+    for(int i = 0; i < populationSize; ++i)
+    {
+      int r1, r2;
+      do
+        r1 = member(gen);
+      while(r1 == i);
+      do
+        r2 = member(gen);
+      while(r2 == i || r2 == r1);
+
+      const glm::vec3 mutant = population[i] + config.F * (population[best] - population[i])
+                               + config.F * (population[r1] - population[r2]);
+
+      glm::vec3 trial  = population[i];
+      const int forced = coordinate(gen);  // at least one coordinate comes from the mutant
+      for(int c = 0; c < 3; ++c)
+        if(c == forced || uniform(gen) < config.CR)
+          trial[c] = mutant[c];
+
+      trials[i] = glm::length(trial) > 1e-6f ? glm::normalize(trial) : population[i];
+    }
+
+    std::vector<RendererResult> trialResults = co_await evaluate(trials);
+
+    const float previousBest = results[best].volume;
+    for(int i = 0; i < populationSize; ++i)
+    {
+      if(trialResults[i].volume < results[i].volume)
+      {
+        population[i] = trials[i];
+        results[i]    = trialResults[i];
+      }
+    }
+    best = bestIndex();
+
+    if(results[best].volume < previousBest)
+      timeSinceLastBest = 0;
+    else if(++timeSinceLastBest > config.K)
+      break;
+
+    // Collapsed population
+    const float minCos = std::cos(config.MinSpread);
+    if(std::all_of(population.begin(), population.end(),
+                   [&](const glm::vec3& p) { return glm::dot(p, population[best]) >= minCos; }))
+      break;
+  }
+
+  std::cout << "[Evolution] " << generation << " generations, best volume " << results[best].volume << "\n";
+
+  // Optimize further
+  co_await requestVolumeForQuat(results[best].rotation, true);
+  currentVolume   = results[best].volume;
+  currentRotation = results[best].rotation;
+
+  HookeJeeves localOptimizer = HookeJeeves(*this, config.LastPointDeltaStart, config.LastPointDeltaEnd, config.LastPointMaxSteps);
+  co_await localOptimizer.optimize();
+
+  bestVolume   = localOptimizer.getBestVolume();
+  bestRotation = localOptimizer.getBestRotation();
+
+  std::cout << "Best volume is:" << bestVolume << "\n";
+
+  // Finish
+  co_return AlgoResult(bestVolume, bestRotation);
+}
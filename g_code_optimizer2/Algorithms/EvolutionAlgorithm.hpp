@@ -0,0 +1,57 @@
+#pragma once
+#include "Algorithm.hpp"
+
+#include "include/json_helpers.hpp"
+#include "include/app_config.hpp"
+
+#include <random>
+
+// Differential evolution on the sphere of camera positions
+// 1) evaluate a random population as one batch
+// 2) build a trial point for every member (DE/current-to-best/1, binomial crossover, projected to the sphere),
+//    evaluate the generation as one batch, a member is only replaced by a better trial (elites are never lost)
+// 3) end after K generations without improvement or when the population collapsed
+// 4) optimize the best one further
+class EvolutionAlgorithm : public Algorithm
+{
+  struct Config
+  {
+    int   PopulationSize = 48;      // evaluations per generation
+    int   MaxGenerations = 200;
+    int   K              = 20;      // end when no improvement after K generations
+    float F              = 0.5f;    // differential weight
+    float CR             = 0.9f;    // crossover probability per coordinate
+    float MinSpread      = 0.001f;  // end when all members are closer to the best (radians)
+    int   Seed           = 0;       // 0: random seed, the run is not repeatable
+
+    // Parameters for local optimization of last point
+    float LastPointDeltaStart = 0.03f;
+    float LastPointDeltaEnd   = 0.00001f;
+    int   LastPointMaxSteps   = 100;
+  };
+  const Config config;
+
+  std::mt19937 gen;
+
+public:
+  AlgoTask algorithmLogic() override;
+  bool     isDeterministic() const override { return config.Seed != 0; }
+  EvolutionAlgorithm()
+      : Algorithm()
+      , config(getJsonConfig<Config>(AppConfig::instance().getAlgorithmsPath() / "evolution.json"))
+      , gen(config.Seed != 0 ? (unsigned)config.Seed : std::random_device{}())
+  {
+  }
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(EvolutionAlgorithm::Config,
+                                   PopulationSize,
+                                   MaxGenerations,
+                                   K,
+                                   F,
+                                   CR,
+                                   MinSpread,
+                                   Seed,
+                                   LastPointDeltaStart,
+                                   LastPointDeltaEnd,
+                                   LastPointMaxSteps)
@@ -1,10 +1,13 @@
 #include "FibonacciPoints.hpp"
+#include "../camera_math.hpp"
 
-AlgoTask generateFibonacciPoints(Algorithm& algo, int N, std::function<void(glm::vec3)> callback)
+std::vector<glm::vec3> fibonacciPoints(int N)
 {
   const float goldenRatio = (1.0f + sqrtf(5.0f)) * 0.5f;
   const float goldenAngle = 2.0f * glm::pi<float>() / goldenRatio;
 
+  std::vector<glm::vec3> points;
+  points.reserve(2 * N + 1);
   for(int i = -N; i <= N; ++i)
   {
     float z     = (2.0f * i) / (2.0f * N + 1.0f);
@@ -14,11 +17,64 @@ AlgoTask generateFibonacciPoints(Algorithm& algo, int N, std::function<void(glm:
 
     float x = r * cosf(theta);
     float y = r * sinf(theta);
+    points.push_back({x, y, z});
+  }
+  return points;
+}
+
+AlgoTask generateFibonacciPoints(Algorithm&                                            algo,
+                                 int                                                   N,
+                                 std::function<void(glm::vec3, const RendererResult&)> callback,
+                                 std::function<bool(const glm::quat&)>                 prune,
+                                 int                                                   batchSize)
+{
+  const std::vector<glm::vec3> allPoints = fibonacciPoints(N);
 
-    co_await algo.requestVolumeForPosition({x, y, z});
+  std::vector<glm::vec3> points;
+  std::vector<glm::quat> rotations;
 
-    callback({x, y, z});
+  for(size_t i = 0; i < allPoints.size(); ++i)
+  {
+    glm::quat rotation = camera_math::positionToRotation(allPoints[i]);
+    if(!prune || !prune(rotation))
+    {
+      points.push_back(allPoints[i]);
+      rotations.push_back(rotation);
+    }
+    if((int)rotations.size() < batchSize && i + 1 < allPoints.size())
+      continue;
+
+    std::vector<RendererResult> results = co_await algo.requestVolumesForBatch(rotations);
+    for(size_t j = 0; j < points.size(); ++j)
+      callback(points[j], results[j]);
+
+    points.clear();
+    rotations.clear();
   }
 
   co_return {};
 }
+
+FibonacciProxyFilter::FibonacciProxyFilter(const Algorithm& algo, int N, float fraction)
+    : active(algo.hasProxy() && fraction < 1.0f)
+{
+  std::vector<glm::quat> rotations;
+  if(active)
+  {
+    for(const glm::vec3& point : fibonacciPoints(N))
+      rotations.push_back(camera_math::positionToRotation(point));
+  }
+  outsideBest = algo.proxyFilter(rotations, fraction);
+}
+
+std::function<bool(const glm::quat&)> FibonacciProxyFilter::combine(std::function<bool(const glm::quat&)> prune)
+{
+  return [this, prune = std::move(prune)](const glm::quat& rotation) {
+    if(outsideBest(rotation))
+    {
+      skipped++;
+      return true;
+    }
+    return prune && prune(rotation);
+  };
+}
@@ -2,4 +2,34 @@
 
 #include "Algorithm.hpp"
 
-AlgoTask generateFibonacciPoints(Algorithm& algo, int N, std::function<void(glm::vec3)> callback);
+// 2N+1 points evenly spread over the unit sphere
+std::vector<glm::vec3> fibonacciPoints(int N);
+
+// Points of fibonacciPoints are evaluated in batches of batchSize rotations
+// callback gets every point with its result, in order
+// prune: points for which it returns true are skipped (not evaluated, no callback), checked when the batch is built
+AlgoTask generateFibonacciPoints(Algorithm&                                            algo,
+                                 int                                                   N,
+                                 std::function<void(glm::vec3, const RendererResult&)> callback,
+                                 std::function<bool(const glm::quat&)>                 prune     = {},
+                                 int                                                   batchSize = 64);
+
+// Proxy pre-filter of a Fibonacci sweep: Algorithm::proxyFilter over the rotations of fibonacciPoints(N)
+// Inactive without a proxy or with fraction >= 1, the points it skips are counted
+class FibonacciProxyFilter
+{
+public:
+  FibonacciProxyFilter(const Algorithm& algo, int N, float fraction);
+
+  bool isActive() const { return active; }
+  int  getSkipped() const { return skipped; }
+
+  // Prune predicate of the sweep, prune is only called for the points inside the best fraction
+  // The filter has to outlive the sweep
+  std::function<bool(const glm::quat&)> combine(std::function<bool(const glm::quat&)> prune);
+
+private:
+  bool                                  active = false;
+  std::function<bool(const glm::quat&)> outsideBest;
+  int                                   skipped = 0;
+};
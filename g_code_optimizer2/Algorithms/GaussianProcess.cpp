@@ -0,0 +1,125 @@
+#include "GaussianProcess.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+double GaussianProcess::kernel(const glm::dvec3& a, const glm::dvec3& b, double scale) const
+{
+  const double r = std::sqrt(5.0) * glm::length(a - b) / scale;
+  return (1 + r + r * r / 3) * std::exp(-r);
+}
+
+void GaussianProcess::forwardSubstitute(const std::vector<double>& factor, std::vector<double>& b) const
+{
+  const size_t n = b.size();
+  for(size_t i = 0; i < n; ++i)
+  {
+    double sum = b[i];
+    for(size_t k = 0; k < i; ++k)
+      sum -= factor[i * n + k] * b[k];
+    b[i] = sum / factor[i * n + i];
+  }
+}
+
+bool GaussianProcess::factorize(const std::vector<double>& normalized,
+                                double                     scale,
+                                std::vector<double>&       outL,
+                                std::vector<double>&       outAlpha,
+                                double&                    logLikelihood) const
+{
+  const size_t n = points.size();
+  outL.assign(n * n, 0.0);
+  for(size_t i = 0; i < n; ++i)
+  {
+    for(size_t j = 0; j <= i; ++j)
+    {
+      double sum = kernel(points[i], points[j], scale) + (i == j ? NOISE : 0.0);
+      for(size_t k = 0; k < j; ++k)
+        sum -= outL[i * n + k] * outL[j * n + k];
+
+      if(i == j)
+      {
+        if(sum <= 0)
+          return false;
+        outL[i * n + i] = std::sqrt(sum);
+      }
+      else
+        outL[i * n + j] = sum / outL[j * n + j];
+    }
+  }
+
+  // alpha = L^-T * L^-1 * y
+  outAlpha = normalized;
+  forwardSubstitute(outL, outAlpha);
+  double fit = 0;
+  for(double v : outAlpha)
+    fit += v * v;
+  for(size_t i = n; i-- > 0;)
+  {
+    double sum = outAlpha[i];
+    for(size_t k = i + 1; k < n; ++k)
+      sum -= outL[k * n + i] * outAlpha[k];
+    outAlpha[i] = sum / outL[i * n + i];
+  }
+
+  double logDet = 0;
+  for(size_t i = 0; i < n; ++i)
+    logDet += std::log(outL[i * n + i]);
+  logLikelihood = -0.5 * fit - logDet;
+  return true;
+}
+
+bool GaussianProcess::fit(const std::vector<glm::dvec3>& newPoints, const std::vector<double>& values, const std::vector<double>& lengthScales)
+{
+  points = newPoints;
+
+  const double n = (double)values.size();
+  valueMean      = std::accumulate(values.begin(), values.end(), 0.0) / n;
+  double var     = 0;
+  for(double v : values)
+    var += (v - valueMean) * (v - valueMean);
+  valueScale = var > 0 ? std::sqrt(var / n) : 1.0;
+
+  std::vector<double> normalized;
+  for(double v : values)
+    normalized.push_back((v - valueMean) / valueScale);
+
+  double bestLikelihood = -std::numeric_limits<double>::infinity();
+  bool   fitted         = false;
+  for(double scale : lengthScales)
+  {
+    std::vector<double> candidateL, candidateAlpha;
+    double              likelihood;
+    if(!factorize(normalized, scale, candidateL, candidateAlpha, likelihood) || likelihood <= bestLikelihood)
+      continue;
+
+    bestLikelihood = likelihood;
+    lengthScale    = scale;
+    L              = std::move(candidateL);
+    alpha          = std::move(candidateAlpha);
+    fitted         = true;
+  }
+  return fitted;
+}
+
+GaussianProcess::Prediction GaussianProcess::predict(const glm::dvec3& point) const
+{
+  const size_t        n = points.size();
+  std::vector<double> k(n);
+  for(size_t i = 0; i < n; ++i)
+    k[i] = kernel(point, points[i], lengthScale);
+
+  double mean = 0;
+  for(size_t i = 0; i < n; ++i)
+    mean += k[i] * alpha[i];
+
+  // var = k(x, x) - |L^-1 k|^2
+  forwardSubstitute(L, k);
+  double variance = 1.0;
+  for(double v : k)
+    variance -= v * v;
+
+  return {valueMean + valueScale * mean, std::max(variance, 0.0) * valueScale * valueScale};
+}
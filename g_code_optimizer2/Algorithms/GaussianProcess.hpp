@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// Gaussian process regression over unit directions
+// Matern 5/2 kernel of the chordal distance (positive definite on the sphere as a restriction from R^3),
+// values are normalized to zero mean and unit variance before fitting
+class GaussianProcess
+{
+public:
+  struct Prediction
+  {
+    double mean;
+    double variance;
+  };
+
+  // Fits with the length scale (chordal distance) of the best marginal likelihood, returns false if no fit succeeded
+  bool fit(const std::vector<glm::dvec3>& points, const std::vector<double>& values, const std::vector<double>& lengthScales);
+
+  Prediction predict(const glm::dvec3& point) const;
+
+  double getLengthScale() const { return lengthScale; }
+
+private:
+  static constexpr double NOISE = 1e-6;  // relative to the normalized variance, keeps the Cholesky factor stable
+
+  std::vector<glm::dvec3> points;
+  std::vector<double>     L;      // lower Cholesky factor of the kernel matrix, row major
+  std::vector<double>     alpha;  // K^-1 * normalized values
+  double                  valueMean   = 0;
+  double                  valueScale  = 1;
+  double                  lengthScale = 1;
+
+  double kernel(const glm::dvec3& a, const glm::dvec3& b, double scale) const;
+
+  // Factorization and log marginal likelihood for one length scale, false if the matrix is not positive definite
+  bool factorize(const std::vector<double>& normalized, double scale, std::vector<double>& outL, std::vector<double>& outAlpha, double& logLikelihood) const;
+
+  // Solves L * x = b in place
+  void forwardSubstitute(const std::vector<double>& factor, std::vector<double>& b) const;
+};
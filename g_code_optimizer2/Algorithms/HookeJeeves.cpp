@@ -1,4 +1,7 @@
 #include "HookeJeeves.hpp"
+#include "../camera_math.hpp"
+
+#include <array>
 
 // Loop:
 // 1) Make exploratory moves
@@ -92,34 +95,31 @@ AlgoTask HookeJeeves::Explore()
 }
 
 // Helpers
+// Both directions are evaluated in one batch, the move prefers +delta like a sequential search, so the search path is
+// the same. Compared to the sequential search, -delta is also evaluated (and counts against maxEvals) when +delta is
+// already better
 AlgoTask HookeJeeves::ExploreInAxis(int axis)
 {
-  //auto      bestVolume   = data.currentVolume;
-  glm::vec2 bestDir{0, 0};
   glm::vec2 testingDir{0, 0};
-
-  // move in direction
   testingDir[axis] = deltaStep;
-  co_await algo.requestVolumeForMove(testingDir);
-  if(algo.getCurrentVolume() >= currentVolume)
-  {  // Result is worse or same, try other direction
-
-    // reset
-    co_await algo.requestVolumeForQuat(currentRotation, true);
-
-    // move in the opposite direction
-    testingDir[axis] = -deltaStep;
-    co_await algo.requestVolumeForMove(testingDir);
-    if(algo.getCurrentVolume() >= currentVolume)
-    {  // Result is worse in both axis, not moving
-      // Reset to original position
-      co_await algo.requestVolumeForQuat(currentRotation, true);
-      co_return {};
+
+  const std::array<glm::quat, 2> rotations = {camera_math::moveRotation(currentRotation, testingDir),
+                                              camera_math::moveRotation(currentRotation, -testingDir)};
+  std::vector<RendererResult>    results   = co_await algo.requestVolumesForBatch(rotations);
+
+  for(int i = 0; i < 2; i++)
+  {
+    if(results[i].volume < currentVolume)
+    {
+      // Move to the first better option
+      currentVolume         = results[i].volume;
+      currentRotation       = results[i].rotation;
+      directionVector[axis] = i == 0 ? deltaStep : -deltaStep;
+      break;
     }
   }
 
-  // Move to the best option
-  currentVolume         = algo.getCurrentVolume();
-  currentRotation       = algo.getCurrentRotation();
-  directionVector[axis] = testingDir[axis];
+  // Batch leaves the camera at the last rotation, following moves are relative to the camera
+  co_await algo.requestVolumeForQuat(currentRotation, true);
+  co_return {};
 }
@@ -0,0 +1,136 @@
+#include "IcospherePoints.hpp"
+#include "../camera_math.hpp"
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
+namespace {
+struct Icosphere
+{
+  std::vector<glm::vec3>               vertices;
+  std::vector<float>                   volumes;  // max for not evaluated or pruned
+  std::vector<std::array<uint32_t, 3>> faces;
+
+  std::unordered_map<uint64_t, uint32_t> midpoints;  // by edge
+
+  uint32_t addVertex(glm::vec3 v)
+  {
+    vertices.push_back(glm::normalize(v));
+    volumes.push_back(std::numeric_limits<float>::max());
+    return uint32_t(vertices.size() - 1);
+  }
+
+  // Shared by both faces of the edge, new vertices are appended to created
+  uint32_t midpoint(uint32_t a, uint32_t b, std::vector<uint32_t>& created)
+  {
+    const uint64_t key = a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+    auto           it  = midpoints.find(key);
+    if(it != midpoints.end())
+      return it->second;
+
+    const uint32_t v = addVertex(vertices[a] + vertices[b]);
+    midpoints.emplace(key, v);
+    created.push_back(v);
+    return v;
+  }
+};
+
+Icosphere makeIcosahedron()
+{
+  const float t = (1.0f + sqrtf(5.0f)) * 0.5f;
+
+  Icosphere ico;
+  for(glm::vec3 v : {glm::vec3(-1, t, 0), glm::vec3(1, t, 0), glm::vec3(-1, -t, 0), glm::vec3(1, -t, 0),
+                     glm::vec3(0, -1, t), glm::vec3(0, 1, t), glm::vec3(0, -1, -t), glm::vec3(0, 1, -t),
+                     glm::vec3(t, 0, -1), glm::vec3(t, 0, 1), glm::vec3(-t, 0, -1), glm::vec3(-t, 0, 1)})
+    ico.addVertex(v);
+
+  ico.faces = {{0, 11, 5}, {0, 5, 1},   {0, 1, 7},  {0, 7, 10}, {0, 10, 11},  //
+               {1, 5, 9},  {5, 11, 4},  {11, 10, 2}, {10, 7, 6}, {7, 1, 8},   //
+               {3, 9, 4},  {3, 4, 2},   {3, 2, 6},  {3, 6, 8},  {3, 8, 9},    //
+               {4, 9, 5},  {2, 4, 11},  {6, 2, 10}, {8, 6, 7},  {9, 8, 1}};
+  return ico;
+}
+
+AlgoTask evaluateVertices(Algorithm&                                                   algo,
+                          Icosphere&                                                   ico,
+                          const std::vector<uint32_t>&                                 indices,
+                          const std::function<void(glm::vec3, const RendererResult&)>& callback,
+                          const std::function<bool(const glm::quat&)>&                 prune,
+                          int                                                          batchSize)
+{
+  std::vector<uint32_t>  batch;
+  std::vector<glm::quat> rotations;
+  for(size_t i = 0; i < indices.size(); ++i)
+  {
+    glm::quat rotation = camera_math::positionToRotation(ico.vertices[indices[i]]);
+    if(!prune || !prune(rotation))
+    {
+      batch.push_back(indices[i]);
+      rotations.push_back(rotation);
+    }
+    if((int)rotations.size() < batchSize && i + 1 < indices.size())
+      continue;
+
+    std::vector<RendererResult> results = co_await algo.requestVolumesForBatch(rotations);
+    for(size_t j = 0; j < batch.size(); ++j)
+    {
+      ico.volumes[batch[j]] = results[j].volume;
+      callback(ico.vertices[batch[j]], results[j]);
+    }
+
+    batch.clear();
+    rotations.clear();
+  }
+  co_return {};
+}
+}  // namespace
+
+AlgoTask generateIcospherePoints(Algorithm&                                            algo,
+                                 int                                                   levels,
+                                 float                                                 tolerance,
+                                 std::function<void(glm::vec3, const RendererResult&)> callback,
+                                 std::function<bool(const glm::quat&)>                 prune,
+                                 int                                                   batchSize)
+{
+  Icosphere ico = makeIcosahedron();
+
+  std::vector<uint32_t> created(ico.vertices.size());
+  for(uint32_t i = 0; i < created.size(); ++i)
+    created[i] = i;
+  co_await evaluateVertices(algo, ico, created, callback, prune, batchSize);
+
+  std::vector<std::array<uint32_t, 3>> active = ico.faces;
+  for(int level = 1; level <= levels && !active.empty(); ++level)
+  {
+    float best = std::numeric_limits<float>::max();
+    for(float volume : ico.volumes)
+      best = std::min(best, volume);
+    const float threshold = best + tolerance * std::abs(best);
+
+    created.clear();
+    std::vector<std::array<uint32_t, 3>> next;
+    for(const auto& [a, b, c] : active)
+    {
+      if(std::min({ico.volumes[a], ico.volumes[b], ico.volumes[c]}) > threshold)
+        continue;
+
+      const uint32_t ab = ico.midpoint(a, b, created);
+      const uint32_t bc = ico.midpoint(b, c, created);
+      const uint32_t ca = ico.midpoint(c, a, created);
+      next.push_back({a, ab, ca});
+      next.push_back({b, bc, ab});
+      next.push_back({c, ca, bc});
+      next.push_back({ab, bc, ca});
+    }
+
+    co_await evaluateVertices(algo, ico, created, callback, prune, batchSize);
+    std::cout << "[Icosphere] Level " << level << ": " << next.size() / 4 << " of " << active.size() << " faces split, "
+              << created.size() << " new points\n";
+    active = std::move(next);
+  }
+
+  std::cout << "[Icosphere] " << ico.vertices.size() << " points\n";
+  co_return {};
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Algorithm.hpp"
+
+#include <nlohmann/json.hpp>
+
+// Sampling of the global sweeps
+enum class SweepSampling
+{
+  Fibonacci,  // 2N+1 uniform points
+  Icosphere,  // adaptive subdivision of an icosahedron
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(SweepSampling, {{SweepSampling::Fibonacci, "fibonacci"}, {SweepSampling::Icosphere, "icosphere"}})
+
+// Hierarchical sweep: evaluates the vertices of an icosahedron, then for each of levels subdivisions splits only the
+// faces with a vertex within tolerance (relative) of the best volume so far
+// Vertices are shared between neighbouring faces and evaluated once, level L has the resolution of 10 * 4^L + 2 points
+// callback, prune and batchSize work as in generateFibonacciPoints, pruned vertices count as worse than any volume
+AlgoTask generateIcospherePoints(Algorithm&                                            algo,
+                                 int                                                   levels,
+                                 float                                                 tolerance,
+                                 std::function<void(glm::vec3, const RendererResult&)> callback,
+                                 std::function<bool(const glm::quat&)>                 prune     = {},
+                                 int                                                   batchSize = 64);
@@ -0,0 +1,86 @@
+#include "MultiFidelityAlgorithm.hpp"
+#include "../camera_math.hpp"
+#include "FibonacciPoints.hpp"
+#include "HookeJeeves.hpp"
+
+#include <algorithm>
+
+AlgoTask MultiFidelityAlgorithm::evaluateRung(std::span<const glm::quat>   rotations,
+                                              std::vector<RendererResult>& results)
+{
+  results.clear();
+  for(size_t first = 0; first < rotations.size(); first += BATCH_SIZE)
+  {
+    std::vector<RendererResult> batch =
+        co_await requestVolumesForBatch(rotations.subspan(first, std::min(BATCH_SIZE, rotations.size() - first)));
+    results.insert(results.end(), batch.begin(), batch.end());
+  }
+  std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) { return a.volume < b.volume; });
+  co_return {};
+}
+
+AlgoTask MultiFidelityAlgorithm::algorithmLogic()
+{
+  const int rungs = std::max({config.StartLod, config.StartResolution, 0}) + 1;
+  const int eta   = std::max(config.Eta, 2);
+
+  // Candidates of the first rung
+  std::vector<glm::quat> candidates;
+  for(const glm::vec3& point : fibonacciPoints(config.N))
+    candidates.push_back(camera_math::positionToRotation(point));
+
+  if(hasProxy() && config.ProxyFraction < 1.0f)
+  {
+    const size_t points = candidates.size();
+    std::erase_if(candidates, proxyFilter(candidates, config.ProxyFraction));
+    std::cout << "[MultiFidelity] Proxy kept " << candidates.size() << " of " << points << " points\n";
+  }
+
+  // The proxy counts a face lying on the bed as overhang, the face down seeds are always candidates
+  const size_t seedCount = std::min<size_t>(std::max(config.FacetSeeds, 0), seedDirections.size());
+  for(size_t i = 0; i < seedCount; ++i)
+    candidates.push_back(camera_math::positionToRotation(seedDirections[i]));
+
+  std::vector<RendererResult> results;
+  for(int rung = 0; rung < rungs; ++rung)
+  {
+    const int level = rungs - 1 - rung;
+    setLod(std::clamp(config.StartLod, 0, level));
+    setResolutionLevel(std::clamp(config.StartResolution, 0, level));
+
+    co_await evaluateRung(candidates, results);
+    std::cout << "[MultiFidelity] Rung " << rung << " (lod " << getLod() << ", resolution level "
+              << getResolutionLevel() << "): " << results.size() << " candidates, best volume "
+              << results.front().volume << "\n";
+
+    if(rung + 1 == rungs)
+      break;
+
+    // Promote the best ones, at least MinCandidates
+    const size_t minKeep = std::min<size_t>(std::max(config.MinCandidates, 1), results.size());
+    const size_t keep    = std::clamp<size_t>((results.size() + eta - 1) / eta, minKeep, results.size());
+    candidates.clear();
+    for(size_t i = 0; i < keep; ++i)
+      candidates.push_back(results[i].rotation);
+  }
+
+  // Last rung is the full fidelity
+  setLod(0);
+  setResolutionLevel(0);
+
+  // Optimize further
+  co_await requestVolumeForQuat(results.front().rotation, true);
+  currentVolume   = results.front().volume;
+  currentRotation = results.front().rotation;
+
+  HookeJeeves localOptimizer = HookeJeeves(*this, config.LastPointDeltaStart, config.LastPointDeltaEnd, config.LastPointMaxSteps);
+  co_await localOptimizer.optimize();
+
+  bestVolume   = localOptimizer.getBestVolume();
+  bestRotation = localOptimizer.getBestRotation();
+
+  std::cout << "Best volume is:" << bestVolume << "\n";
+
+  // Finish
+  co_return AlgoResult(bestVolume, bestRotation);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Algorithm.hpp"
+
+#include "include/json_helpers.hpp"
+#include "include/app_config.hpp"
+
+// Successive halving over fidelities, only promising candidates are evaluated at a higher fidelity
+// 0) overhang proxy keeps the best fraction of the Fibonacci points (face down seeds are always kept)
+// 1) evaluate all candidates at the coarsest fidelity (coarse level of detail and grid)
+// 2) promote the best 1/Eta to the next fidelity, one level finer, until the full mesh at the full resolution
+// 3) optimize the best full fidelity candidate further
+//
+// Rung r of R uses level R - 1 - r clamped to StartLod and StartResolution, the last rung is always the full fidelity
+class MultiFidelityAlgorithm : public Algorithm
+{
+  struct Config
+  {
+    int   N               = 2000;   // 2N+1 Fibonacci points
+    float ProxyFraction   = 0.25f;  // best fraction of the points by the overhang proxy, 1 evaluates all
+    int   FacetSeeds      = 8;      // face down directions of the largest facet clusters, added to the candidates
+    int   StartLod        = 1;      // level of detail of the first rung
+    int   StartResolution = 3;      // resolution level of the first rung (grid halved per level)
+    int   Eta             = 3;      // 1/Eta of the candidates are promoted to the next rung
+    int   MinCandidates   = 8;      // candidates of the last rung
+
+    // Parameters for local optimization of last point
+    float LastPointDeltaStart = 0.03f;
+    float LastPointDeltaEnd   = 0.00001f;
+    int   LastPointMaxSteps   = 100;
+  };
+  const Config config;
+
+  static constexpr size_t BATCH_SIZE = 64;
+
+  // Volumes of the rotations at the current fidelity, sorted by volume
+  AlgoTask evaluateRung(std::span<const glm::quat> rotations, std::vector<RendererResult>& results);
+
+public:
+  AlgoTask algorithmLogic() override;
+  MultiFidelityAlgorithm()
+      : Algorithm()
+      , config(getJsonConfig<Config>(AppConfig::instance().getAlgorithmsPath() / "multifidelity.json"))
+  {
+  }
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(MultiFidelityAlgorithm::Config,
+                                   N,
+                                   ProxyFraction,
+                                   FacetSeeds,
+                                   StartLod,
+                                   StartResolution,
+                                   Eta,
+                                   MinCandidates,
+                                   LastPointDeltaStart,
+                                   LastPointDeltaEnd,
+                                   LastPointMaxSteps)
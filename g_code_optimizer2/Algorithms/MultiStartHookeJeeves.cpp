@@ -0,0 +1,110 @@
+#include "MultiStartHookeJeeves.hpp"
+#include "AlgorithmSync.hpp"
+
+void MultiStartHookeJeeves::addStart(glm::quat rotation, float volume)
+{
+  auto search       = std::make_unique<Search>(algo, rotation, volume);
+  search->optimizer = std::make_unique<HookeJeeves>(*search, deltaStep, tolerance, maxSteps);
+  searches.push_back(std::move(search));
+}
+
+std::vector<glm::quat> MultiStartHookeJeeves::requestedRotations(const Search& search, const AlgoRequestAny& request)
+{
+  return std::visit(overloaded{
+                        [&](const AlgoRequestNewQuat& r) { return std::vector<glm::quat>{r.newQuat}; },
+                        [&](const AlgoRequestNewPos& r) {
+                          return std::vector<glm::quat>{camera_math::positionToRotation(r.newPosition)};
+                        },
+                        [&](const AlgoRequestMoveDir& r) {
+                          return std::vector<glm::quat>{camera_math::moveRotation(search.camera, r.moveDirection)};
+                        },
+                        [&](const AlgoRequestBatch& r) { return r.rotations; },
+                    },
+                    request);
+}
+
+void MultiStartHookeJeeves::advance(Search& search)
+{
+  auto& p = search.task->h.promise();
+  while(!search.task->h.done())
+  {
+    const AlgoRequestAny& request = p.algo_request.value();
+    if(!std::visit([](const auto& r) { return r.skipCalculation; }, request))
+      return;
+
+    // Only moves the camera of the search
+    std::vector<glm::quat> rotations = requestedRotations(search, request);
+    search.camera                    = rotations.back();
+    p.renderer_result                = {0, search.camera};
+    p.renderer_results.clear();
+    for(const auto& rotation : rotations)
+      p.renderer_results.push_back({0, rotation});
+    p.algo_request.reset();
+    p.active.resume();
+  }
+}
+
+AlgoTask MultiStartHookeJeeves::optimize()
+{
+  // Run every search to its first request
+  for(auto& search : searches)
+  {
+    search->task.emplace(search->optimizer->optimize());
+    search->task->h.resume();
+    advance(*search);
+  }
+
+  while(true)
+  {
+    // Pending requests of all searches as absolute rotations
+    std::vector<glm::quat> rotations;
+    for(auto& search : searches)
+    {
+      search->firstResult = rotations.size();
+      search->resultCount = 0;
+      if(search->task->h.done())
+        continue;
+
+      std::vector<glm::quat> requested = requestedRotations(*search, search->task->h.promise().algo_request.value());
+      rotations.insert(rotations.end(), requested.begin(), requested.end());
+      search->resultCount = rotations.size() - search->firstResult;
+    }
+
+    if(rotations.empty())
+      break;
+
+    std::vector<RendererResult> results = co_await algo.requestVolumesForBatch(rotations);
+
+    // Resume every search with its part of the batch
+    for(auto& search : searches)
+    {
+      if(search->task->h.done())
+        continue;
+
+      auto& p = search->task->h.promise();
+      if(search->resultCount > 0)
+      {
+        auto first = results.begin() + search->firstResult;
+        if(std::holds_alternative<AlgoRequestBatch>(p.algo_request.value()))
+          p.renderer_results.assign(first, first + search->resultCount);
+        else
+          p.renderer_result = *first;
+        search->camera = first[search->resultCount - 1].rotation;
+      }
+
+      p.algo_request.reset();
+      p.active.resume();
+      advance(*search);
+    }
+  }
+
+  for(auto& search : searches)
+  {
+    if(search->optimizer->getBestVolume() < bestVolume)
+    {
+      bestVolume   = search->optimizer->getBestVolume();
+      bestRotation = search->optimizer->getBestRotation();
+    }
+  }
+  co_return {};
+}
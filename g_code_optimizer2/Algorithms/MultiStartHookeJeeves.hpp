@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Algorithm.hpp"
+#include "HookeJeeves.hpp"
+
+#include <memory>
+
+// Several HookeJeeves searches interleaved as independent coroutines
+// Every step the pending requests of all searches are evaluated as one batch, the number of renderer round trips is
+// the number of steps of the longest search instead of the sum over all searches
+// Each search gets the same evaluations as when run alone, the results don't depend on the interleaving
+class MultiStartHookeJeeves
+{
+public:
+  MultiStartHookeJeeves(Algorithm& algo, float deltaStep, float tolerance, int maxSteps)
+      : algo(algo)
+      , deltaStep(deltaStep)
+      , tolerance(tolerance)
+      , maxSteps(maxSteps)
+  {
+  }
+
+  // Start point of one search, volume is the evaluated volume of the rotation
+  void addStart(glm::quat rotation, float volume);
+
+  AlgoTask optimize();
+
+  // Best over all searches, ties go to the search added first
+  float     getBestVolume() { return bestVolume; }
+  glm::quat getBestRotation() { return bestRotation; }
+
+private:
+  // Requests of a search go to its own root task, its camera is only moved by its own requests
+  class Search : public Algorithm
+  {
+  public:
+    Search(Algorithm& parent, glm::quat rotation, float volume)
+    {
+      currentRotation = rotation;
+      currentVolume   = volume;
+      setEvaluationMode(parent.getEvaluationMode());
+      setLod(parent.getLod());
+      setResolutionLevel(parent.getResolutionLevel());
+      camera = rotation;
+    }
+
+    AlgoTask algorithmLogic() override { co_return {}; }
+
+    std::unique_ptr<HookeJeeves> optimizer;
+    std::optional<AlgoTask>      task;
+    glm::quat                    camera;
+    size_t                       firstResult = 0;  // index of its first rotation in the shared batch
+    size_t                       resultCount = 0;
+  };
+
+  Algorithm& algo;
+
+  float deltaStep;
+  float tolerance;
+  int   maxSteps;
+
+  std::vector<std::unique_ptr<Search>> searches;
+
+  float     bestVolume = std::numeric_limits<float>::max();
+  glm::quat bestRotation{};
+
+  // Rotations the request evaluates, moves are relative to the camera of the search
+  static std::vector<glm::quat> requestedRotations(const Search& search, const AlgoRequestAny& request);
+
+  // Resumes the search until it waits for an evaluation (skipped requests are answered here)
+  void advance(Search& search);
+};
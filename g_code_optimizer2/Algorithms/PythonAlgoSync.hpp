@@ -32,6 +32,9 @@ public:
     CloseHandle(sem_response);
   }
 
+  // External optimizer, its state is unknown
+  bool isDeterministic() const override { return false; }
+
 private:
   AlgoTask algorithmLogic();
 };
@@ -3,6 +3,7 @@
 #include "HookeJeeves.hpp"
 
 #include <glm/glm.hpp>
+#include <algorithm>
 #include <random>
 #include <cmath>
 
@@ -25,6 +26,8 @@ AlgoTask StochasticAlgorithm::algorithmLogic()
   glm::quat globalBestRotation{};
   float     globalBestbestVolume = std::numeric_limits<float>::max();
 
+  const int seedCount = std::min(std::max(config.FacetSeeds, 0), (int)seedDirections.size());
+
   for(int iGlobal = 0; iGlobal < config.NGlobal; ++iGlobal)
   {
     timeSinceLastBest = 0;
@@ -32,13 +35,14 @@ AlgoTask StochasticAlgorithm::algorithmLogic()
     // std::cout << "Generate and optimize N random candidates...\n";
     for(int i = 0; i < config.N; ++i)
     {
-      // Generate random normalized point
-      glm::vec3 point = randomDirection();
+      // Generate random normalized point, seeds first in the first shot (always optimized)
+      const bool seed  = iGlobal == 0 && i < seedCount;
+      glm::vec3  point = seed ? seedDirections[i] : randomDirection();
 
       // Set position to the point
       co_await requestVolumeForPosition(point);
 
-      if(currentVolume < bestVolume * (1 + config.differenceFromBestFrac))
+      if(seed || currentVolume < bestVolume * (1 + config.differenceFromBestFrac))
       {
         // Run local optimizer
         HookeJeeves localOptimizer = HookeJeeves(*this, config.KPointsDeltaStart, config.KPointsDeltaEnd, config.KPointsMaxSteps);
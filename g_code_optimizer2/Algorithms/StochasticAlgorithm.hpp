@@ -19,6 +19,7 @@ class StochasticAlgorithm : public Algorithm
     int   NGlobal                = 20;     // Maximum NGlobal shots
     int   KGlobal                = 5;      // end when no improvement after KGlobal shots
     float differenceFromBestFrac = 0;      // how much can generated point differ
+    int   FacetSeeds             = 0;      // face down directions of the largest facet clusters, first points of the first shot
 
     // Parameters for local optimization of N points
     float KPointsDeltaStart = 0.1f;
@@ -38,6 +39,7 @@ class StochasticAlgorithm : public Algorithm
 
 public:
   AlgoTask algorithmLogic() override;
+  bool     isDeterministic() const override { return false; }
   StochasticAlgorithm()
       : Algorithm()
       , config(getJsonConfig<Config>(AppConfig::instance().getAlgorithmsPath() / "stochastic.json"))
@@ -51,6 +53,7 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(StochasticAlgorithm::Config,
                                    NGlobal,
                                    KGlobal,
                                    differenceFromBestFrac,
+                                   FacetSeeds,
                                    KPointsDeltaStart,
                                    KPointsDeltaEnd,
                                    KPointsMaxSteps,
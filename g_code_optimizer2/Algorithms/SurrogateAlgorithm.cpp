@@ -0,0 +1,132 @@
+#include "SurrogateAlgorithm.hpp"
+#include "../camera_math.hpp"
+#include "FibonacciPoints.hpp"
+#include "TangentPlane.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+namespace {
+// Expected improvement below the best value (minimization)
+double expectedImprovement(const GaussianProcess::Prediction& prediction, double best)
+{
+  const double sigma = std::sqrt(prediction.variance);
+  const double gain  = best - prediction.mean;
+  if(sigma < 1e-12)
+    return std::max(gain, 0.0);
+
+  const double z   = gain / sigma;
+  const double cdf = 0.5 * std::erfc(-z / std::numbers::sqrt2);
+  const double pdf = std::exp(-0.5 * z * z) / std::sqrt(2 * std::numbers::pi);
+  return gain * cdf + sigma * pdf;
+}
+
+// Chord length of an angle on the unit sphere
+double chord(double angle)
+{
+  return 2 * std::sin(0.5 * angle);
+}
+}  // namespace
+
+void SurrogateAlgorithm::addEvaluation(glm::dvec3 point, const RendererResult& result)
+{
+  points.push_back(point);
+  volumes.push_back(result.volume);
+  if(result.volume < bestVolume)
+  {
+    bestVolume   = result.volume;
+    bestRotation = result.rotation;
+  }
+}
+
+std::vector<glm::dvec3> SurrogateAlgorithm::selectBatch(const GaussianProcess&         model,
+                                                        const std::vector<glm::dvec3>& candidates,
+                                                        double&                        bestImprovement) const
+{
+  std::vector<std::pair<double, size_t>> improvements;
+  improvements.reserve(candidates.size());
+  for(size_t i = 0; i < candidates.size(); ++i)
+    improvements.push_back({expectedImprovement(model.predict(candidates[i]), bestVolume), i});
+  std::sort(improvements.begin(), improvements.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  bestImprovement = improvements.empty() ? 0 : improvements.front().first;
+
+  // Greedy, the exclusion keeps the batch from sampling one peak several times
+  const double            exclusion = chord(config.ExclusionRadius);
+  std::vector<glm::dvec3> batch;
+  for(const auto& [improvement, index] : improvements)
+  {
+    if((int)batch.size() >= config.BatchSize || improvement < config.MinImprovement * std::abs(bestVolume))
+      break;
+
+    const glm::dvec3& candidate = candidates[index];
+    if(std::none_of(batch.begin(), batch.end(), [&](const glm::dvec3& p) { return glm::length(p - candidate) < exclusion; }))
+      batch.push_back(candidate);
+  }
+  return batch;
+}
+
+AlgoTask SurrogateAlgorithm::algorithmLogic()
+{
+  std::mt19937                     gen(config.Seed);
+  std::normal_distribution<double> normal(0.0, 1.0);
+
+  // Initial design
+  co_await generateFibonacciPoints(*this, config.InitialN,
+                                   [this](glm::vec3 point, const RendererResult& result) { addEvaluation(glm::dvec3(point), result); });
+
+  std::vector<glm::dvec3> globalCandidates;
+  for(const glm::vec3& point : fibonacciPoints(config.CandidateN))
+    globalCandidates.push_back(glm::dvec3(point));
+
+  GaussianProcess model;
+  while((int)points.size() < config.MaxEvaluations)
+  {
+    if(!model.fit(points, volumes, config.LengthScales))
+    {
+      std::cout << "[Surrogate] Model fit failed\n";
+      break;
+    }
+
+    // Global candidates and refinement around the best point, half of them closer by a factor of 10
+    std::vector<glm::dvec3> candidates = globalCandidates;
+    const size_t            best       = std::min_element(volumes.begin(), volumes.end()) - volumes.begin();
+    const TangentPlane      plane(points[best]);
+    for(int i = 0; i < config.LocalCandidates; ++i)
+    {
+      const double radius = i % 2 == 0 ? config.LocalRadius : 0.1 * config.LocalRadius;
+      candidates.push_back(plane.toSphere(radius * glm::dvec2(normal(gen), normal(gen))));
+    }
+
+    double                  improvement;
+    std::vector<glm::dvec3> batch = selectBatch(model, candidates, improvement);
+    if(batch.empty())
+      break;
+    batch.resize(std::min<size_t>(batch.size(), config.MaxEvaluations - points.size()));
+
+    std::vector<glm::quat> rotations;
+    for(const glm::dvec3& point : batch)
+      rotations.push_back(camera_math::positionToRotation(glm::vec3(point)));
+
+    std::vector<RendererResult> results = co_await requestVolumesForBatch(rotations);
+    for(size_t i = 0; i < results.size(); ++i)
+      addEvaluation(batch[i], results[i]);
+
+    std::cout << "[Surrogate] " << points.size() << " evaluations, best volume " << bestVolume << ", expected improvement "
+              << improvement << ", length scale " << model.getLengthScale() << "\n";
+  }
+
+  std::cout << "[Surrogate] Used " << points.size() << " evaluations";
+  if(deterministicIterations)
+    std::cout << ", saved " << *deterministicIterations - (int)points.size() << " compared to deterministic ("
+              << *deterministicIterations << " evaluations)\n";
+  else
+    std::cout << ", no deterministic run recorded\n";
+
+  std::cout << "Best volume is:" << bestVolume << "\n";
+
+  // Finish
+  co_return AlgoResult(bestVolume, bestRotation);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Algorithm.hpp"
+#include "GaussianProcess.hpp"
+
+#include "include/json_helpers.hpp"
+#include "include/app_config.hpp"
+
+// Bayesian optimization over the sphere of camera positions
+// 1) evaluate a coarse Fibonacci design
+// 2) fit a Gaussian process to all evaluations
+// 3) evaluate the batch of candidates with the largest expected improvement
+// 4) repeat 2-3 until the expected improvement is below the threshold
+// Result is the best evaluated point
+class SurrogateAlgorithm : public Algorithm
+{
+  struct Config
+  {
+    int                 InitialN        = 40;                    // 2N+1 Fibonacci points of the initial design
+    int                 CandidateN      = 1000;                  // 2N+1 Fibonacci points searched for the expected improvement
+    int                 LocalCandidates = 200;                   // random candidates around the best point
+    float               LocalRadius     = 0.1f;                  // spread of the local candidates (radians)
+    int                 BatchSize       = 8;                     // evaluations per step
+    float               ExclusionRadius = 0.05f;                 // min distance between points of one batch (radians)
+    int                 MaxEvaluations  = 600;                   // including the initial design
+    float               MinImprovement  = 0.001f;                // end when the expected improvement is below (relative to the best)
+    std::vector<double> LengthScales    = {0.1, 0.2, 0.4, 0.8};  // kernel length scales tried by each fit (chordal distance)
+    int                 Seed            = 1;
+  };
+  const Config config;
+
+  std::vector<glm::dvec3> points;  // evaluated camera positions
+  std::vector<double>     volumes;
+
+  void addEvaluation(glm::dvec3 point, const RendererResult& result);
+
+  // Points with the largest expected improvement, at most BatchSize, further apart than ExclusionRadius
+  std::vector<glm::dvec3> selectBatch(const GaussianProcess& model, const std::vector<glm::dvec3>& candidates, double& bestImprovement) const;
+
+public:
+  AlgoTask algorithmLogic() override;
+  SurrogateAlgorithm()
+      : Algorithm()
+      , config(getJsonConfig<Config>(AppConfig::instance().getAlgorithmsPath() / "surrogate.json"))
+  {
+  }
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(SurrogateAlgorithm::Config, InitialN, CandidateN, LocalCandidates, LocalRadius, BatchSize, ExclusionRadius, MaxEvaluations, MinImprovement, LengthScales, Seed)
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glm/gtx/quaternion.hpp>
+
+#include <cmath>
+
+// Local chart of the sphere of camera positions around a center direction
+// Points of the plane map to the sphere by the exponential map (length of the point is the angle from the center),
+// so steps and distances in the plane are angles on the sphere
+struct TangentPlane
+{
+  glm::dvec3 center{0, 0, 1};
+  glm::dvec3 axisX{1, 0, 0};
+  glm::dvec3 axisY{0, 1, 0};
+
+  TangentPlane() = default;
+  explicit TangentPlane(glm::dvec3 direction) { setCenter(direction); }
+
+  // New basis of the plane, any orthonormal pair perpendicular to the center
+  void setCenter(glm::dvec3 direction)
+  {
+    center            = glm::normalize(direction);
+    glm::dvec3 helper = std::abs(center.x) < 0.9 ? glm::dvec3(1, 0, 0) : glm::dvec3(0, 1, 0);
+    axisX             = glm::normalize(glm::cross(helper, center));
+    axisY             = glm::cross(center, axisX);
+  }
+
+  // Moves the center, the basis is carried along the geodesic so vectors in the plane keep their meaning
+  void moveCenter(glm::dvec3 direction)
+  {
+    direction              = glm::normalize(direction);
+    const glm::dvec3 axis  = glm::cross(center, direction);
+    const double     sinA  = glm::length(axis);
+    const double     cosA  = glm::dot(center, direction);
+    if(sinA < 1e-12)
+    {
+      // Antipodal move has no unique geodesic
+      if(cosA < 0)
+        setCenter(direction);
+      return;
+    }
+
+    const glm::dquat rotation = glm::angleAxis(std::atan2(sinA, cosA), axis / sinA);
+    center                    = direction;
+    axisX                     = glm::normalize(rotation * axisX);
+    axisY                     = glm::cross(center, axisX);
+  }
+
+  glm::dvec3 toSphere(glm::dvec2 point) const
+  {
+    const double angle = glm::length(point);
+    if(angle < 1e-12)
+      return center;
+    const glm::dvec2 dir = point / angle;
+    return glm::normalize(std::cos(angle) * center + std::sin(angle) * (dir.x * axisX + dir.y * axisY));
+  }
+
+  glm::dvec2 toPlane(glm::dvec3 direction) const
+  {
+    direction          = glm::normalize(direction);
+    const glm::dvec2 p = {glm::dot(direction, axisX), glm::dot(direction, axisY)};
+    const double     s = glm::length(p);
+    if(s < 1e-12)
+      return {0, 0};
+    return p / s * std::atan2(s, glm::dot(direction, center));
+  }
+};
@@ -0,0 +1,160 @@
+#include "AnalyticEvaluator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+}  // namespace
+
+AnalyticEvaluator::AnalyticEvaluator(const std::vector<openstl::Triangle>& triangles, Metric metric, unsigned int threadCount)
+    : bvh(triangles)
+    , metric(metric)
+    , workerPool(threadCount)
+{
+  facets.reserve(triangles.size());
+  for(const auto& t : triangles)
+  {
+    glm::vec3 centroid = (t.v0 + t.v1 + t.v2) / 3.0f;
+
+    Facet facet;
+    facet.areaVector = 0.5f * glm::cross(t.v1 - t.v0, t.v2 - t.v0);
+    facet.probes[0]  = centroid;
+    facet.probes[1]  = t.v0 + (centroid - t.v0) * PROBE_INSET;
+    facet.probes[2]  = t.v1 + (centroid - t.v1) * PROBE_INSET;
+    facet.probes[3]  = t.v2 + (centroid - t.v2) * PROBE_INSET;
+    facets.push_back(facet);
+  }
+
+  // Relative to the mesh size, same order as the RAY_EPSILON of the shader for ~100mm models
+  const BvhNode& root = bvh.getNodes()[0];
+  probeEpsilon        = glm::length(root.boundsMax - root.boundsMin) * 1e-5f;
+
+  taskResults.resize((facets.size() + FACETS_PER_TASK - 1) / FACETS_PER_TASK);
+}
+
+bool AnalyticEvaluator::tryEvaluate(const VolumeEvaluationView& view, float& volume)
+{
+  auto start = Clock::now();
+  timings.evaluations++;
+
+  // View z of a model position is dot(up, p) + offset
+  const glm::vec3 up(view.viewMatrix[0][2], view.viewMatrix[1][2], view.viewMatrix[2][2]);
+  const float     offset = view.viewMatrix[3][2] - view.aabbMin.z;
+
+  std::atomic<bool> ambiguous = false;
+  workerPool.parallelFor((uint32_t)taskResults.size(), [&](uint32_t task, unsigned int) {
+    TaskResult result;
+
+    const uint32_t first = task * FACETS_PER_TASK;
+    const uint32_t last  = std::min<uint32_t>(first + FACETS_PER_TASK, (uint32_t)facets.size());
+    for(uint32_t i = first; i < last && !ambiguous.load(std::memory_order_relaxed); ++i)
+    {
+      const Facet& facet         = facets[i];
+      const float  projectedArea = glm::dot(facet.areaVector, up);  // < 0 for downward facing facets
+      const float  height        = glm::dot(facet.probes[0], up) + offset;
+
+      // Mesh volume, height is linear over the facet so the centroid height is its average
+      result.meshVolume += double(projectedArea) * double(height);
+
+      if(projectedArea >= 0.0f || height <= probeEpsilon)
+        continue;
+
+      float gap;
+      if(!probeGap(facet, up, offset, gap, result.probes))
+      {
+        result.ambiguous = true;
+        ambiguous.store(true, std::memory_order_relaxed);
+        break;
+      }
+      result.support += double(-projectedArea) * double(gap);
+    }
+
+    taskResults[task] = result;
+  });
+
+  TaskResult total;
+  for(const TaskResult& result : taskResults)
+  {
+    total.meshVolume += result.meshVolume;
+    total.support += result.support;
+    total.probes += result.probes;
+  }
+  timings.probes += total.probes;
+  timings.evaluateMs += elapsedMs(start);
+
+  if(ambiguous)
+  {
+    timings.fallbacks++;
+    return false;
+  }
+
+  double result = metric == Metric::HeightField ? total.meshVolume + total.support : total.support;
+  volume        = (float)std::max(result, 0.0);
+  return true;
+}
+
+bool AnalyticEvaluator::probeGap(const Facet& facet, const glm::vec3& up, float offset, float& gap, uint64_t& probeCount) const
+{
+  constexpr uint32_t noTriangle = ~0u;
+
+  // Plane of the surface below the centroid
+  uint32_t  centroidTriangle = noTriangle;
+  glm::vec3 planeNormal{};
+  float     planeDistance = 0;
+  for(uint32_t p = 0; p < PROBE_COUNT; ++p)
+  {
+    const float height   = glm::dot(facet.probes[p], up) + offset;
+    RayHit      hit;
+    uint32_t    triangle = noTriangle;
+    if(!bvh.intersectClosest(facet.probes[p], -up, probeEpsilon, height, hit, triangle))
+      triangle = noTriangle;
+    probeCount++;
+
+    if(p == 0)
+    {
+      centroidTriangle = triangle;
+      gap              = triangle == noTriangle ? height : hit.t;
+      if(triangle != noTriangle)
+      {
+        const BvhTriangle& below = bvh.getTriangles()[triangle];
+        planeNormal              = glm::normalize(glm::cross(below.edge1, below.edge2));
+        planeDistance            = glm::dot(planeNormal, below.v0);
+      }
+      continue;
+    }
+
+    if(triangle == centroidTriangle)
+      continue;
+
+    // Different surfaces below the facet, the gap is linear only if they share the plane
+    if(triangle == noTriangle || centroidTriangle == noTriangle)
+      return false;
+
+    const BvhTriangle& below  = bvh.getTriangles()[triangle];
+    const glm::vec3    normal = glm::normalize(glm::cross(below.edge1, below.edge2));
+    if(glm::dot(normal, planeNormal) < 1.0f - PLANE_TOLERANCE
+       || std::abs(glm::dot(normal, below.v0) - planeDistance) > probeEpsilon)
+      return false;
+  }
+  return true;
+}
+
+void AnalyticEvaluator::printStats() const
+{
+  if(timings.evaluations == 0)
+    return;
+
+  std::cout << "[Analytic] evaluations: " << timings.evaluations << ", fallbacks: " << timings.fallbacks
+            << ", facets: " << facets.size() << ", threads: " << workerPool.getThreadCount() << "\n";
+  std::cout << "[Analytic] per evaluation (ms): " << timings.evaluateMs / double(timings.evaluations) << ", probes "
+            << double(timings.probes) / double(timings.evaluations) << "\n";
+}
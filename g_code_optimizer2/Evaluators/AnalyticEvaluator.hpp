@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+
+#include "VolumeEvaluator.hpp"
+#include "Bvh.hpp"
+#include "WorkerPool.hpp"
+#include "stl.h"
+
+// Support volume from the facets without sampling columns
+// Every downward facing facet needs support from its surface down to the next surface below (or the bottom):
+//   support = sum(projected area * gap at the centroid)
+// The gap is found by probing straight down from the centroid and from points near the corners of the facet.
+// When all probes see the same plane (or nothing) the gap is linear over the facet and the sum is exact,
+// otherwise occlusion is ambiguous and tryEvaluate fails so the caller can use a full evaluator.
+//
+// Metric::HeightField matches the raster pipeline: the integral of the top surface height, which is the mesh
+// volume (divergence theorem over all facets) plus the support volume
+// Metric::Support matches the ray tracing pipeline: the support volume only
+//
+// The value is continuous, raster/ray results differ from it by their sampling error
+class AnalyticEvaluator
+{
+public:
+  static constexpr uint32_t FACETS_PER_TASK = 1024;
+  static constexpr float    PROBE_INSET     = 0.05f;  // corner probes are moved towards the centroid by this fraction
+  static constexpr float    PLANE_TOLERANCE = 1e-5f;  // 1 - cos of the angle between coplanar triangles below a facet
+
+  enum class Metric
+  {
+    HeightField,  // raster pipeline
+    Support,      // ray tracing pipeline
+  };
+
+  // Timings accumulated over all evaluations
+  struct Timings
+  {
+    uint64_t evaluations = 0;
+    uint64_t fallbacks   = 0;  // ambiguous evaluations
+    uint64_t probes      = 0;
+    double   evaluateMs  = 0;
+  };
+
+  // threadCount = 0 uses all hardware threads
+  AnalyticEvaluator(const std::vector<openstl::Triangle>& triangles, Metric metric, unsigned int threadCount = 0);
+
+  // Returns false when occlusion is ambiguous, volume is not changed in that case
+  bool tryEvaluate(const VolumeEvaluationView& view, float& volume);
+  void printStats() const;
+
+  const Timings& getTimings() const { return timings; }
+  Metric         getMetric() const { return metric; }
+
+private:
+  static constexpr uint32_t PROBE_COUNT = 4;  // centroid + 3 corners
+
+  struct Facet
+  {
+    glm::vec3 areaVector;  // cross(v1 - v0, v2 - v0) / 2, dot with a direction is the signed projected area
+    glm::vec3 probes[PROBE_COUNT];
+  };
+
+  // Partial sums of one task, summed in order so the result doesn't depend on scheduling
+  struct TaskResult
+  {
+    double   meshVolume = 0;
+    double   support    = 0;
+    uint64_t probes     = 0;
+    bool     ambiguous  = false;
+  };
+
+  Bvh                     bvh;
+  Metric                  metric;
+  float                   probeEpsilon = 0;  // TMin of the probes, skips the facet itself
+  std::vector<Facet>      facets;
+  std::vector<TaskResult> taskResults;
+
+  WorkerPool workerPool;
+  Timings    timings;
+
+  // Gap below the centroid of one facet (up: view z in model space, offset: view z of the model origin above the bottom)
+  // Returns false when the probes see different planes below the facet
+  bool probeGap(const Facet& facet, const glm::vec3& up, float offset, float& gap, uint64_t& probeCount) const;
+};
@@ -0,0 +1,269 @@
+#include "Bvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace {
+struct Bounds
+{
+  glm::vec3 min{std::numeric_limits<float>::max()};
+  glm::vec3 max{-std::numeric_limits<float>::max()};
+
+  void grow(const glm::vec3& p)
+  {
+    min = glm::min(min, p);
+    max = glm::max(max, p);
+  }
+  void grow(const Bounds& b)
+  {
+    min = glm::min(min, b.min);
+    max = glm::max(max, b.max);
+  }
+  bool valid() const { return min.x <= max.x; }
+  float area() const
+  {
+    if(!valid())
+      return 0.0f;
+    glm::vec3 e = max - min;
+    return e.x * e.y + e.y * e.z + e.z * e.x;
+  }
+};
+
+struct Bin
+{
+  Bounds   bounds;
+  uint32_t count = 0;
+};
+
+struct BuildTask
+{
+  uint32_t node;
+  uint32_t depth;
+};
+}  // namespace
+
+Bvh::Bvh(const std::vector<openstl::Triangle>& stlTriangles)
+{
+  const uint32_t triangleCount = (uint32_t)stlTriangles.size();
+
+  std::vector<Bounds>    triangleBounds(triangleCount);
+  std::vector<glm::vec3> centroids(triangleCount);
+  std::vector<uint32_t>  indices(triangleCount);
+  for(uint32_t i = 0; i < triangleCount; ++i)
+  {
+    const auto& t = stlTriangles[i];
+    triangleBounds[i].grow(t.v0);
+    triangleBounds[i].grow(t.v1);
+    triangleBounds[i].grow(t.v2);
+    centroids[i] = (t.v0 + t.v1 + t.v2) / 3.0f;
+    indices[i]   = i;
+  }
+
+  nodes.reserve(std::max(1u, 2 * triangleCount));
+  nodes.push_back({.boundsMin = glm::vec3(0.0f), .first = 0, .boundsMax = glm::vec3(0.0f), .count = triangleCount});
+
+  std::vector<BuildTask> stack{{0, 1}};
+  while(!stack.empty())
+  {
+    BuildTask task = stack.back();
+    stack.pop_back();
+    depth = std::max(depth, task.depth);
+
+    BvhNode& node  = nodes[task.node];
+    uint32_t first = node.first;
+    uint32_t count = node.count;
+
+    Bounds bounds, centroidBounds;
+    for(uint32_t i = first; i < first + count; ++i)
+    {
+      bounds.grow(triangleBounds[indices[i]]);
+      centroidBounds.grow(centroids[indices[i]]);
+    }
+    if(count > 0)
+    {
+      node.boundsMin = bounds.min;
+      node.boundsMax = bounds.max;
+    }
+
+    if(count <= 2 || task.depth >= MAX_DEPTH)
+      continue;
+
+    // Binned SAH over all axes
+    float    bestCost  = std::numeric_limits<float>::max();
+    int      bestAxis  = -1;
+    uint32_t bestSplit = 0;
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+      if(extent <= 0.0f)
+        continue;
+
+      std::array<Bin, BIN_COUNT> bins{};
+      const float                scale = float(BIN_COUNT) / extent;
+      for(uint32_t i = first; i < first + count; ++i)
+      {
+        uint32_t bin = std::min(BIN_COUNT - 1, uint32_t((centroids[indices[i]][axis] - centroidBounds.min[axis]) * scale));
+        bins[bin].count++;
+        bins[bin].bounds.grow(triangleBounds[indices[i]]);
+      }
+
+      // Sweep from the right to get the area/count of every right side
+      std::array<float, BIN_COUNT - 1>    rightArea{};
+      std::array<uint32_t, BIN_COUNT - 1> rightCount{};
+      Bounds                              right;
+      uint32_t                            rightSum = 0;
+      for(uint32_t b = BIN_COUNT - 1; b > 0; --b)
+      {
+        right.grow(bins[b].bounds);
+        rightSum += bins[b].count;
+        rightArea[b - 1]  = right.area();
+        rightCount[b - 1] = rightSum;
+      }
+
+      Bounds   left;
+      uint32_t leftSum = 0;
+      for(uint32_t b = 0; b < BIN_COUNT - 1; ++b)
+      {
+        left.grow(bins[b].bounds);
+        leftSum += bins[b].count;
+        if(leftSum == 0 || rightCount[b] == 0)
+          continue;
+
+        float cost = float(leftSum) * left.area() + float(rightCount[b]) * rightArea[b];
+        if(cost < bestCost)
+        {
+          bestCost  = cost;
+          bestAxis  = axis;
+          bestSplit = b + 1;
+        }
+      }
+    }
+
+    // All centroids at the same position
+    if(bestAxis < 0)
+      continue;
+
+    // Traversal cost of one node ~ one triangle test
+    const float leafCost  = float(count);
+    const float splitCost = 1.0f + bestCost / bounds.area();
+    if(splitCost >= leafCost && count <= MAX_LEAF_SIZE)
+      continue;
+
+    // Partition
+    const float scale = float(BIN_COUNT) / (centroidBounds.max[bestAxis] - centroidBounds.min[bestAxis]);
+    auto        mid   = std::partition(indices.begin() + first, indices.begin() + first + count, [&](uint32_t index) {
+      uint32_t bin = std::min(BIN_COUNT - 1, uint32_t((centroids[index][bestAxis] - centroidBounds.min[bestAxis]) * scale));
+      return bin < bestSplit;
+    });
+    uint32_t leftCount = uint32_t(mid - (indices.begin() + first));
+
+    uint32_t leftChild = (uint32_t)nodes.size();
+    nodes.push_back({.boundsMin = glm::vec3(0.0f), .first = first, .boundsMax = glm::vec3(0.0f), .count = leftCount});
+    nodes.push_back({.boundsMin = glm::vec3(0.0f), .first = first + leftCount, .boundsMax = glm::vec3(0.0f), .count = count - leftCount});
+
+    // push_back may reallocate
+    nodes[task.node].first = leftChild;
+    nodes[task.node].count = 0;
+
+    stack.push_back({leftChild + 1, task.depth + 1});
+    stack.push_back({leftChild, task.depth + 1});
+  }
+
+  // Empty mesh, root is an empty inner node
+  if(triangleCount == 0)
+  {
+    nodes[0].boundsMin = glm::vec3(1.0f);
+    nodes[0].boundsMax = glm::vec3(-1.0f);
+  }
+
+  triangles.reserve(triangleCount);
+  for(uint32_t index : indices)
+  {
+    const auto& t = stlTriangles[index];
+    triangles.push_back({t.v0, t.v1 - t.v0, t.v2 - t.v0});
+  }
+}
+
+void Bvh::intersectAll(const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax, std::vector<RayHit>& hits) const
+{
+  const glm::vec3 invDir = safeInverseDirection(direction);
+
+  std::array<uint32_t, MAX_DEPTH + 1> stack;
+  uint32_t                            stackSize = 0;
+  stack[stackSize++]                          = 0;
+
+  while(stackSize > 0)
+  {
+    const BvhNode& node = nodes[stack[--stackSize]];
+
+    // Slab test
+    glm::vec3 t0   = (node.boundsMin - origin) * invDir;
+    glm::vec3 t1   = (node.boundsMax - origin) * invDir;
+    glm::vec3 tLo  = glm::min(t0, t1);
+    glm::vec3 tHi  = glm::max(t0, t1);
+    float     tIn  = std::max({tLo.x, tLo.y, tLo.z, tMin});
+    float     tOut = std::min({tHi.x, tHi.y, tHi.z, tMax});
+    if(tIn > tOut)
+      continue;
+
+    if(!node.isLeaf())
+    {
+      stack[stackSize++] = node.first;
+      stack[stackSize++] = node.first + 1;
+      continue;
+    }
+
+    for(uint32_t i = node.first; i < node.first + node.count; ++i)
+    {
+      RayHit hit;
+      if(intersectTriangle(triangles[i], origin, direction, hit) && hit.t >= tMin && hit.t <= tMax)
+        hits.push_back(hit);
+    }
+  }
+}
+
+bool Bvh::intersectClosest(const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax, RayHit& hit, uint32_t& triangleIndex) const
+{
+  const glm::vec3 invDir = safeInverseDirection(direction);
+
+  std::array<uint32_t, MAX_DEPTH + 1> stack;
+  uint32_t                            stackSize = 0;
+  stack[stackSize++]                          = 0;
+
+  bool found = false;
+  while(stackSize > 0)
+  {
+    const BvhNode& node = nodes[stack[--stackSize]];
+
+    // Slab test against the closest hit so far
+    glm::vec3 t0   = (node.boundsMin - origin) * invDir;
+    glm::vec3 t1   = (node.boundsMax - origin) * invDir;
+    glm::vec3 tLo  = glm::min(t0, t1);
+    glm::vec3 tHi  = glm::max(t0, t1);
+    float     tIn  = std::max({tLo.x, tLo.y, tLo.z, tMin});
+    float     tOut = std::min({tHi.x, tHi.y, tHi.z, tMax});
+    if(tIn > tOut)
+      continue;
+
+    if(!node.isLeaf())
+    {
+      stack[stackSize++] = node.first;
+      stack[stackSize++] = node.first + 1;
+      continue;
+    }
+
+    for(uint32_t i = node.first; i < node.first + node.count; ++i)
+    {
+      RayHit candidate;
+      if(intersectTriangle(triangles[i], origin, direction, candidate) && candidate.t >= tMin && candidate.t <= tMax)
+      {
+        hit           = candidate;
+        triangleIndex = i;
+        tMax          = candidate.t;
+        found         = true;
+      }
+    }
+  }
+  return found;
+}
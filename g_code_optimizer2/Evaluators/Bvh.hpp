@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "stl.h"
+
+// Node of the BVH, 32 bytes
+struct BvhNode
+{
+  glm::vec3 boundsMin;
+  uint32_t  first;  // leaf: first triangle, inner: left child (right child is first + 1)
+  glm::vec3 boundsMax;
+  uint32_t  count;  // triangles in the leaf, 0 for inner nodes
+
+  bool isLeaf() const { return count > 0; }
+};
+
+// Triangle prepared for Moller-Trumbore intersection
+// cross(edge1, edge2) is the face normal used by stl_utils (cross(v1 - v0, v2 - v0))
+struct BvhTriangle
+{
+  glm::vec3 v0;
+  glm::vec3 edge1;
+  glm::vec3 edge2;
+};
+
+// Parallel rays (same direction) traced together, orthographic columns of one row
+struct RayPacket
+{
+  static constexpr uint32_t SIZE = 8;
+
+  alignas(32) float originX[SIZE];
+  alignas(32) float originY[SIZE];
+  alignas(32) float originZ[SIZE];
+  alignas(32) float tMax[SIZE];
+  uint32_t          count = 0;  // active lanes [0, count)
+};
+
+struct RayHit
+{
+  float t;
+  bool  frontFace;  // dot(rayDirection, normal) < 0, same test as rchitMain
+};
+
+// Bounding volume hierarchy over the mesh triangles (model space)
+// Built once with binned SAH, used by the CPU ray casting evaluator
+class Bvh
+{
+public:
+  static constexpr uint32_t BIN_COUNT     = 16;
+  static constexpr uint32_t MAX_LEAF_SIZE = 8;
+  static constexpr uint32_t MAX_DEPTH     = 64;
+
+  explicit Bvh(const std::vector<openstl::Triangle>& triangles);
+
+  // Appends all hits with tMin <= t <= tMax (unsorted)
+  // Triangles are two sided, degenerate triangles are never hit
+  void intersectAll(const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax, std::vector<RayHit>& hits) const;
+
+  // intersectAll for all rays of the packet, node visits are shared
+  // Box and triangle tests are done for 8 rays at once with AVX2, requires cpuSupportsAvx2() on x64
+  // hits: one vector per lane
+  void intersectPacket(const RayPacket& packet, const glm::vec3& direction, float tMin, std::vector<RayHit>* hits) const;
+
+  // Closest hit with tMin <= t <= tMax, triangleIndex is the index into getTriangles()
+  bool intersectClosest(const glm::vec3& origin, const glm::vec3& direction, float tMin, float tMax, RayHit& hit, uint32_t& triangleIndex) const;
+
+  const std::vector<BvhNode>&     getNodes() const { return nodes; }
+  const std::vector<BvhTriangle>& getTriangles() const { return triangles; }
+  uint32_t                        getDepth() const { return depth; }
+
+private:
+  std::vector<BvhNode>     nodes;
+  std::vector<BvhTriangle> triangles;  // sorted by leaf
+  uint32_t                 depth = 0;
+};
+
+// 1 / direction without infinities, axis aligned rays starting on a box plane would produce 0 * inf = NaN
+inline glm::vec3 safeInverseDirection(const glm::vec3& direction)
+{
+  constexpr float minComponent = 1e-20f;
+
+  glm::vec3 inv;
+  for(int i = 0; i < 3; ++i)
+  {
+    float d = direction[i];
+    if(std::abs(d) < minComponent)
+      d = d < 0.0f ? -minComponent : minComponent;
+    inv[i] = 1.0f / d;
+  }
+  return inv;
+}
+
+// Moller-Trumbore, returns false for misses and for rays parallel to the triangle
+inline bool intersectTriangle(const BvhTriangle& triangle, const glm::vec3& origin, const glm::vec3& direction, RayHit& hit)
+{
+  const glm::vec3 pvec = glm::cross(direction, triangle.edge2);
+  const float     det  = glm::dot(triangle.edge1, pvec);
+  if(det == 0.0f)
+    return false;
+
+  const float     invDet = 1.0f / det;
+  const glm::vec3 tvec   = origin - triangle.v0;
+  const float     u      = glm::dot(tvec, pvec) * invDet;
+  if(u < 0.0f || u > 1.0f)
+    return false;
+
+  const glm::vec3 qvec = glm::cross(tvec, triangle.edge1);
+  const float     v    = glm::dot(direction, qvec) * invDet;
+  if(v < 0.0f || u + v > 1.0f)
+    return false;
+
+  // det = -dot(direction, cross(edge1, edge2))
+  hit.t         = glm::dot(triangle.edge2, qvec) * invDet;
+  hit.frontFace = det > 0.0f;
+  return true;
+}
@@ -0,0 +1,150 @@
+#include "Bvh.hpp"
+#include "CpuFeatures.hpp"
+
+#include <array>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+
+// Same expressions as intersectAll / intersectTriangle (glm::dot and glm::cross operand order),
+// every lane finds the same hits as the single ray traversal
+CPU_TARGET_AVX2 CPU_NO_FP_CONTRACT void Bvh::intersectPacket(const RayPacket&   packet,
+                                                             const glm::vec3&   direction,
+                                                             float              tMin,
+                                                             std::vector<RayHit>* hits) const
+{
+  static_assert(RayPacket::SIZE == 8, "AVX2 packet is 8 rays wide");
+
+  const glm::vec3 invDir = safeInverseDirection(direction);
+
+  const __m256 ox    = _mm256_load_ps(packet.originX);
+  const __m256 oy    = _mm256_load_ps(packet.originY);
+  const __m256 oz    = _mm256_load_ps(packet.originZ);
+  const __m256 tMaxV = _mm256_load_ps(packet.tMax);
+  const __m256 tMinV = _mm256_set1_ps(tMin);
+  const __m256 zero  = _mm256_setzero_ps();
+  const __m256 one   = _mm256_set1_ps(1.0f);
+  const __m256 invDx = _mm256_set1_ps(invDir.x);
+  const __m256 invDy = _mm256_set1_ps(invDir.y);
+  const __m256 invDz = _mm256_set1_ps(invDir.z);
+  const __m256 dx    = _mm256_set1_ps(direction.x);
+  const __m256 dy    = _mm256_set1_ps(direction.y);
+  const __m256 dz    = _mm256_set1_ps(direction.z);
+
+  const __m256 lanes  = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+  const __m256 active = _mm256_cmp_ps(lanes, _mm256_set1_ps(float(packet.count)), _CMP_LT_OQ);
+
+  std::array<uint32_t, MAX_DEPTH + 1> stack;
+  uint32_t                            stackSize = 0;
+  stack[stackSize++]                          = 0;
+
+  alignas(32) float laneT[RayPacket::SIZE];
+
+  while(stackSize > 0)
+  {
+    const BvhNode& node = nodes[stack[--stackSize]];
+
+    // Slab test of all rays, the node is visited once if any ray overlaps it
+    __m256 t0x  = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.boundsMin.x), ox), invDx);
+    __m256 t1x  = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.boundsMax.x), ox), invDx);
+    __m256 t0y  = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.boundsMin.y), oy), invDy);
+    __m256 t1y  = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.boundsMax.y), oy), invDy);
+    __m256 t0z  = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.boundsMin.z), oz), invDz);
+    __m256 t1z  = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(node.boundsMax.z), oz), invDz);
+    __m256 tIn  = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(t0x, t1x), _mm256_min_ps(t0y, t1y)),
+                                _mm256_max_ps(_mm256_min_ps(t0z, t1z), tMinV));
+    __m256 tOut = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(t0x, t1x), _mm256_max_ps(t0y, t1y)),
+                                _mm256_min_ps(_mm256_max_ps(t0z, t1z), tMaxV));
+
+    __m256 overlap = _mm256_and_ps(_mm256_cmp_ps(tIn, tOut, _CMP_LE_OQ), active);
+    if(_mm256_movemask_ps(overlap) == 0)
+      continue;
+
+    if(!node.isLeaf())
+    {
+      stack[stackSize++] = node.first;
+      stack[stackSize++] = node.first + 1;
+      continue;
+    }
+
+    for(uint32_t i = node.first; i < node.first + node.count; ++i)
+    {
+      const BvhTriangle& triangle = triangles[i];
+
+      // Rays are parallel, pvec and det are shared by all lanes
+      const glm::vec3 pvec = glm::cross(direction, triangle.edge2);
+      const float     det  = glm::dot(triangle.edge1, pvec);
+      if(det == 0.0f)
+        continue;
+      const float invDet = 1.0f / det;
+
+      const __m256 invDetV = _mm256_set1_ps(invDet);
+      const __m256 e1x     = _mm256_set1_ps(triangle.edge1.x);
+      const __m256 e1y     = _mm256_set1_ps(triangle.edge1.y);
+      const __m256 e1z     = _mm256_set1_ps(triangle.edge1.z);
+
+      // tvec = origin - v0
+      const __m256 tvx = _mm256_sub_ps(ox, _mm256_set1_ps(triangle.v0.x));
+      const __m256 tvy = _mm256_sub_ps(oy, _mm256_set1_ps(triangle.v0.y));
+      const __m256 tvz = _mm256_sub_ps(oz, _mm256_set1_ps(triangle.v0.z));
+
+      // u = dot(tvec, pvec) * invDet
+      __m256 u = _mm256_mul_ps(tvx, _mm256_set1_ps(pvec.x));
+      u        = _mm256_add_ps(u, _mm256_mul_ps(tvy, _mm256_set1_ps(pvec.y)));
+      u        = _mm256_add_ps(u, _mm256_mul_ps(tvz, _mm256_set1_ps(pvec.z)));
+      u        = _mm256_mul_ps(u, invDetV);
+
+      __m256 mask = _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ));
+      mask        = _mm256_and_ps(mask, overlap);
+      if(_mm256_movemask_ps(mask) == 0)
+        continue;
+
+      // qvec = cross(tvec, edge1)
+      const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(tvy, e1z), _mm256_mul_ps(e1y, tvz));
+      const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(tvz, e1x), _mm256_mul_ps(e1z, tvx));
+      const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(tvx, e1y), _mm256_mul_ps(e1x, tvy));
+
+      // v = dot(direction, qvec) * invDet
+      __m256 v = _mm256_mul_ps(dx, qx);
+      v        = _mm256_add_ps(v, _mm256_mul_ps(dy, qy));
+      v        = _mm256_add_ps(v, _mm256_mul_ps(dz, qz));
+      v        = _mm256_mul_ps(v, invDetV);
+
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+      if(_mm256_movemask_ps(mask) == 0)
+        continue;
+
+      // t = dot(edge2, qvec) * invDet
+      __m256 t = _mm256_mul_ps(_mm256_set1_ps(triangle.edge2.x), qx);
+      t        = _mm256_add_ps(t, _mm256_mul_ps(_mm256_set1_ps(triangle.edge2.y), qy));
+      t        = _mm256_add_ps(t, _mm256_mul_ps(_mm256_set1_ps(triangle.edge2.z), qz));
+      t        = _mm256_mul_ps(t, invDetV);
+
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, tMinV, _CMP_GE_OQ));
+      mask = _mm256_and_ps(mask, _mm256_cmp_ps(t, tMaxV, _CMP_LE_OQ));
+
+      int laneMask = _mm256_movemask_ps(mask);
+      if(laneMask == 0)
+        continue;
+
+      _mm256_store_ps(laneT, t);
+      const bool frontFace = det > 0.0f;
+      for(uint32_t lane = 0; lane < RayPacket::SIZE; ++lane)
+      {
+        if(laneMask & (1 << lane))
+          hits[lane].push_back({laneT[lane], frontFace});
+      }
+    }
+  }
+}
+#else
+void Bvh::intersectPacket(const RayPacket& packet, const glm::vec3& direction, float tMin, std::vector<RayHit>* hits) const
+{
+  for(uint32_t lane = 0; lane < packet.count; ++lane)
+  {
+    glm::vec3 origin(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+    intersectAll(origin, direction, tMin, packet.tMax[lane], hits[lane]);
+  }
+}
+#endif
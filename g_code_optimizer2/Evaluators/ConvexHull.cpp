@@ -0,0 +1,310 @@
+#include "ConvexHull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+// Face during construction, double precision
+struct WorkFace
+{
+  uint32_t              v[3];
+  glm::dvec3            normal;
+  double                distance = 0;
+  std::vector<uint32_t> outside;  // points above the face, assigned to one face only
+  bool                  alive = true;
+};
+
+uint64_t edgeKey(uint32_t a, uint32_t b)
+{
+  return (uint64_t(a) << 32) | b;
+}
+
+WorkFace makeFace(const std::vector<glm::dvec3>& points, uint32_t a, uint32_t b, uint32_t c)
+{
+  WorkFace face;
+  face.v[0]         = a;
+  face.v[1]         = b;
+  face.v[2]         = c;
+  glm::dvec3 normal = glm::cross(points[b] - points[a], points[c] - points[a]);
+  double     length = glm::length(normal);
+  face.normal       = length > 0.0 ? normal / length : glm::dvec3(0.0);
+  face.distance     = glm::dot(face.normal, points[a]);
+  return face;
+}
+
+double pointDistance(const WorkFace& face, const glm::dvec3& p)
+{
+  return glm::dot(face.normal, p) - face.distance;
+}
+}  // namespace
+
+ConvexHull::ConvexHull(std::span<const glm::vec3> points)
+{
+  build(points);
+  buildAdjacency();
+}
+
+void ConvexHull::build(std::span<const glm::vec3> inputPoints)
+{
+  if(inputPoints.size() < 4)
+    return;
+
+  std::vector<glm::dvec3> points(inputPoints.begin(), inputPoints.end());
+
+  // Initial tetrahedron from the extreme points
+  std::array<uint32_t, 6> extremes{};
+  for(uint32_t i = 0; i < points.size(); ++i)
+  {
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      if(points[i][axis] < points[extremes[axis * 2]][axis])
+        extremes[axis * 2] = i;
+      if(points[i][axis] > points[extremes[axis * 2 + 1]][axis])
+        extremes[axis * 2 + 1] = i;
+    }
+  }
+
+  glm::dvec3 extent(0.0);
+  for(int axis = 0; axis < 3; ++axis)
+    extent[axis] = points[extremes[axis * 2 + 1]][axis] - points[extremes[axis * 2]][axis];
+  const double eps = RELATIVE_EPSILON * glm::length(extent);
+  epsilon          = (float)eps;
+
+  uint32_t i0 = 0, i1 = 0;
+  double   maxDistance = 0;
+  for(uint32_t a : extremes)
+  {
+    for(uint32_t b : extremes)
+    {
+      double distance = glm::length(points[b] - points[a]);
+      if(distance > maxDistance)
+      {
+        maxDistance = distance;
+        i0          = a;
+        i1          = b;
+      }
+    }
+  }
+  if(maxDistance <= eps)
+    return;
+
+  const glm::dvec3 lineDir = (points[i1] - points[i0]) / maxDistance;
+  uint32_t         i2      = 0;
+  maxDistance              = 0;
+  for(uint32_t i = 0; i < points.size(); ++i)
+  {
+    double distance = glm::length(glm::cross(points[i] - points[i0], lineDir));
+    if(distance > maxDistance)
+    {
+      maxDistance = distance;
+      i2          = i;
+    }
+  }
+  if(maxDistance <= eps)
+    return;
+
+  const WorkFace base = makeFace(points, i0, i1, i2);
+  uint32_t       i3   = 0;
+  maxDistance         = 0;
+  for(uint32_t i = 0; i < points.size(); ++i)
+  {
+    double distance = std::abs(pointDistance(base, points[i]));
+    if(distance > maxDistance)
+    {
+      maxDistance = distance;
+      i3          = i;
+    }
+  }
+  if(maxDistance <= eps)
+    return;
+
+  // Faces of the tetrahedron facing away from its centroid
+  const glm::dvec3      centroid = (points[i0] + points[i1] + points[i2] + points[i3]) * 0.25;
+  std::vector<WorkFace> work;
+  for(const auto& [a, b, c] : {std::array{i0, i1, i2}, std::array{i0, i3, i1}, std::array{i0, i2, i3}, std::array{i1, i3, i2}})
+  {
+    WorkFace face = makeFace(points, a, b, c);
+    if(pointDistance(face, centroid) > 0.0)
+      face = makeFace(points, a, c, b);
+    work.push_back(std::move(face));
+  }
+
+  std::unordered_map<uint64_t, uint32_t> edgeFaces;  // directed edge -> face, the neighbour over a->b owns b->a
+  auto                                   addEdges = [&](uint32_t f) {
+    const WorkFace& face = work[f];
+    for(int e = 0; e < 3; ++e)
+      edgeFaces[edgeKey(face.v[e], face.v[(e + 1) % 3])] = f;
+  };
+  for(uint32_t f = 0; f < work.size(); ++f)
+    addEdges(f);
+
+  auto assign = [&](uint32_t point, uint32_t firstFace) {
+    for(uint32_t f = firstFace; f < work.size(); ++f)
+    {
+      if(work[f].alive && pointDistance(work[f], points[point]) > eps)
+      {
+        work[f].outside.push_back(point);
+        return;
+      }
+    }
+  };
+  for(uint32_t i = 0; i < points.size(); ++i)
+  {
+    if(i != i0 && i != i1 && i != i2 && i != i3)
+      assign(i, 0);
+  }
+
+  std::vector<uint32_t>                     visible;
+  std::vector<std::pair<uint32_t, uint32_t>> horizon;
+  std::vector<uint32_t>                     stack;
+  std::vector<uint32_t>                     orphans;
+  for(uint32_t f = 0; f < work.size(); ++f)
+  {
+    if(!work[f].alive || work[f].outside.empty())
+      continue;
+
+    // Farthest point above the face is a hull vertex
+    uint32_t eye      = work[f].outside[0];
+    double   eyeDepth = 0;
+    for(uint32_t point : work[f].outside)
+    {
+      double distance = pointDistance(work[f], points[point]);
+      if(distance > eyeDepth)
+      {
+        eyeDepth = distance;
+        eye      = point;
+      }
+    }
+
+    // Faces seen from the eye (connected), horizon edges keep the winding of the visible faces
+    // Any face strictly below the eye is visible (no epsilon), otherwise the cone can fold over a nearly coplanar face
+    visible.clear();
+    horizon.clear();
+    stack.assign(1, f);
+    work[f].alive = false;
+    while(!stack.empty())
+    {
+      uint32_t current = stack.back();
+      stack.pop_back();
+      visible.push_back(current);
+
+      for(int e = 0; e < 3; ++e)
+      {
+        const uint32_t a        = work[current].v[e];
+        const uint32_t b        = work[current].v[(e + 1) % 3];
+        const uint32_t neighbor = edgeFaces.at(edgeKey(b, a));
+        // Faces removed earlier don't own edges of live faces, a removed neighbour is visible from the eye
+        if(!work[neighbor].alive)
+          continue;
+        if(pointDistance(work[neighbor], points[eye]) > 0.0)
+        {
+          work[neighbor].alive = false;
+          stack.push_back(neighbor);
+        }
+        else
+        {
+          horizon.emplace_back(a, b);
+        }
+      }
+    }
+
+    // Cone from the horizon to the eye
+    const uint32_t firstNew = (uint32_t)work.size();
+    for(const auto& [a, b] : horizon)
+    {
+      work.push_back(makeFace(points, a, b, eye));
+      addEdges((uint32_t)work.size() - 1);
+    }
+
+    orphans.clear();
+    for(uint32_t v : visible)
+    {
+      for(uint32_t point : work[v].outside)
+      {
+        if(point != eye)
+          orphans.push_back(point);
+      }
+      work[v].outside = {};
+    }
+    for(uint32_t point : orphans)
+      assign(point, firstNew);
+  }
+
+  // Compact the vertices used by the faces
+  std::vector<uint32_t> remap(points.size(), ~0u);
+  for(const WorkFace& face : work)
+  {
+    if(!face.alive)
+      continue;
+
+    Face result;
+    for(int i = 0; i < 3; ++i)
+    {
+      if(remap[face.v[i]] == ~0u)
+      {
+        remap[face.v[i]] = (uint32_t)vertices.size();
+        vertices.push_back(inputPoints[face.v[i]]);
+      }
+      result.v[i] = remap[face.v[i]];
+    }
+    result.normal   = glm::vec3(face.normal);
+    result.distance = (float)face.distance;
+    faces.push_back(result);
+  }
+}
+
+void ConvexHull::buildAdjacency()
+{
+  // Every edge a->b of a face has the reverse b->a in the neighbour, so a->b covers all neighbours of a
+  adjacencyStart.assign(vertices.size() + 1, 0);
+  for(const Face& face : faces)
+  {
+    for(int e = 0; e < 3; ++e)
+      adjacencyStart[face.v[e] + 1]++;
+  }
+  for(size_t v = 0; v < vertices.size(); ++v)
+    adjacencyStart[v + 1] += adjacencyStart[v];
+
+  adjacency.resize(adjacencyStart.back());
+  std::vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+  for(const Face& face : faces)
+  {
+    for(int e = 0; e < 3; ++e)
+      adjacency[fill[face.v[e]]++] = face.v[(e + 1) % 3];
+  }
+}
+
+float ConvexHull::support(const glm::vec3& direction, uint32_t& startVertex) const
+{
+  if(vertices.empty())
+    return 0;
+
+  uint32_t current = startVertex < vertices.size() ? startVertex : 0;
+  float    best    = glm::dot(direction, vertices[current]);
+  for(bool improved = true; improved;)
+  {
+    improved = false;
+    for(uint32_t i = adjacencyStart[current]; i < adjacencyStart[current + 1]; ++i)
+    {
+      const float value = glm::dot(direction, vertices[adjacency[i]]);
+      if(value > best)
+      {
+        best     = value;
+        current  = adjacency[i];
+        improved = true;
+        break;
+      }
+    }
+  }
+
+  startVertex = current;
+  return best;
+}
+
+float ConvexHull::support(const glm::vec3& direction) const
+{
+  uint32_t startVertex = 0;
+  return support(direction, startVertex);
+}
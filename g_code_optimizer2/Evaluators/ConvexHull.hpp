@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Convex hull of a point set (quickhull), built once per mesh
+// Faces are triangles with outward normals, coplanar faces are not merged
+class ConvexHull
+{
+public:
+  struct Face
+  {
+    uint32_t  v[3];      // indices into getVertices(), counter-clockwise seen from outside
+    glm::vec3 normal;    // outward, normalized
+    float     distance;  // dot(normal, p) for points p on the face
+  };
+
+  // Points closer than epsilon (relative to the extent of the points) to a face are treated as inside
+  static constexpr double RELATIVE_EPSILON = 1e-6;
+
+  // Flat or degenerate inputs give an empty hull (isValid() is false)
+  explicit ConvexHull(std::span<const glm::vec3> points);
+
+  bool isValid() const { return !faces.empty(); }
+
+  // max dot(direction, v) over the hull vertices
+  // Hill climbing over the vertex neighbours, a local maximum of a linear function on a convex polytope is global
+  // startVertex: vertex to start from, updated to the maximum (coherent queries take a few steps)
+  float support(const glm::vec3& direction, uint32_t& startVertex) const;
+  float support(const glm::vec3& direction) const;
+
+  const std::vector<glm::vec3>& getVertices() const { return vertices; }
+  const std::vector<Face>&      getFaces() const { return faces; }
+  float                         getEpsilon() const { return epsilon; }
+
+private:
+  std::vector<glm::vec3> vertices;
+  std::vector<Face>      faces;
+  float                  epsilon = 0;
+
+  // Vertex adjacency (CSR), neighbours of v are adjacency[adjacencyStart[v], adjacencyStart[v + 1])
+  std::vector<uint32_t> adjacencyStart;
+  std::vector<uint32_t> adjacency;
+
+  void build(std::span<const glm::vec3> points);
+  void buildAdjacency();
+};
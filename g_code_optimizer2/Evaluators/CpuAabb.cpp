@@ -0,0 +1,104 @@
+#include "CpuAabb.hpp"
+#include "CpuFeatures.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+constexpr size_t AABB_LANES = 8;
+
+// view = rotation * vertex, summed in the same order as glm (column 0, 1, 2)
+CPU_NO_FP_CONTRACT void minMaxScalar(const float* xs, const float* ys, const float* zs, size_t count, const glm::mat3& rotation, glm::vec3& outMin, glm::vec3& outMax)
+{
+  for(size_t i = 0; i < count; ++i)
+  {
+    for(int row = 0; row < 3; ++row)
+    {
+      const float t = rotation[0][row] * xs[i] + rotation[1][row] * ys[i] + rotation[2][row] * zs[i];
+      outMin[row]   = std::min(outMin[row], t);
+      outMax[row]   = std::max(outMax[row], t);
+    }
+  }
+}
+
+#if defined(_M_X64) || defined(__x86_64__)
+// count is a multiple of AABB_LANES
+CPU_TARGET_AVX2 CPU_NO_FP_CONTRACT void minMaxAvx2(const float* xs, const float* ys, const float* zs, size_t count, const glm::mat3& rotation, glm::vec3& outMin, glm::vec3& outMax)
+{
+  __m256 m[3][3];
+  __m256 lo[3];
+  __m256 hi[3];
+  for(int row = 0; row < 3; ++row)
+  {
+    for(int column = 0; column < 3; ++column)
+      m[column][row] = _mm256_set1_ps(rotation[column][row]);
+    lo[row] = _mm256_set1_ps(outMin[row]);
+    hi[row] = _mm256_set1_ps(outMax[row]);
+  }
+
+  for(size_t i = 0; i < count; i += AABB_LANES)
+  {
+    const __m256 x = _mm256_loadu_ps(xs + i);
+    const __m256 y = _mm256_loadu_ps(ys + i);
+    const __m256 z = _mm256_loadu_ps(zs + i);
+    for(int row = 0; row < 3; ++row)
+    {
+      __m256 t = _mm256_add_ps(_mm256_mul_ps(m[0][row], x), _mm256_mul_ps(m[1][row], y));
+      t        = _mm256_add_ps(t, _mm256_mul_ps(m[2][row], z));
+      lo[row]  = _mm256_min_ps(lo[row], t);
+      hi[row]  = _mm256_max_ps(hi[row], t);
+    }
+  }
+
+  alignas(32) float lanes[AABB_LANES];
+  for(int row = 0; row < 3; ++row)
+  {
+    _mm256_store_ps(lanes, lo[row]);
+    outMin[row] = *std::min_element(lanes, lanes + AABB_LANES);
+    _mm256_store_ps(lanes, hi[row]);
+    outMax[row] = *std::max_element(lanes, lanes + AABB_LANES);
+  }
+}
+#endif
+}  // namespace
+
+CpuAabb::CpuAabb(std::span<const glm::vec3> vertices)
+    : count(vertices.size())
+{
+#if defined(_M_X64) || defined(__x86_64__)
+  useAvx2 = cpuSupportsAvx2();
+#endif
+
+  const size_t padded = (count + AABB_LANES - 1) / AABB_LANES * AABB_LANES;
+  xs.reserve(padded);
+  ys.reserve(padded);
+  zs.reserve(padded);
+  for(size_t i = 0; i < padded && count > 0; ++i)
+  {
+    const glm::vec3& v = vertices[i < count ? i : 0];
+    xs.push_back(v.x);
+    ys.push_back(v.y);
+    zs.push_back(v.z);
+  }
+}
+
+shaderio::AABB CpuAabb::compute(const glm::mat4& viewMatrix) const
+{
+  const glm::mat3 rotation(viewMatrix);
+
+  glm::vec3 localMin(std::numeric_limits<float>::max());
+  glm::vec3 localMax(std::numeric_limits<float>::lowest());
+#if defined(_M_X64) || defined(__x86_64__)
+  if(useAvx2)
+  {
+    minMaxAvx2(xs.data(), ys.data(), zs.data(), xs.size(), rotation, localMin, localMax);
+    return {localMin, localMax};
+  }
+#endif
+  minMaxScalar(xs.data(), ys.data(), zs.data(), count, rotation, localMin, localMax);
+  return {localMin, localMax};
+}
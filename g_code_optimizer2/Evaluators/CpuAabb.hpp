@@ -0,0 +1,31 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "shaders/shaderio.h"
+
+// CPU implementation of aabb_compute.slang, AABB of the vertices rotated into view space
+// Vertices kept for repeated AABB queries, rotated and reduced 8 at a time with AVX2 when the CPU supports it
+// Usually the convex hull vertices, the extremes of the mesh in any direction are hull vertices
+// Both paths give bit-identical results (same expression order, no FMA)
+class CpuAabb
+{
+public:
+  explicit CpuAabb(std::span<const glm::vec3> vertices);
+
+  shaderio::AABB compute(const glm::mat4& viewMatrix) const;
+
+  size_t getVertexCount() const { return count; }
+  bool   usesAvx2() const { return useAvx2; }
+
+private:
+  // Structure of arrays, padded to a multiple of 8 with copies of the first vertex
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<float> zs;
+  size_t             count   = 0;
+  bool               useAvx2 = false;
+};
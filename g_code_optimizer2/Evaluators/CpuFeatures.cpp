@@ -0,0 +1,70 @@
+#include "CpuFeatures.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+struct CpuFeatures
+{
+  bool avx2   = false;
+  bool avx512 = false;
+};
+
+CpuFeatures queryCpuFeatures()
+{
+  CpuFeatures features;
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if(info[0] < 7)
+    return features;
+
+  __cpuid(info, 1);
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx     = (info[2] & (1 << 28)) != 0;
+  if(!osxsave || !avx)
+    return features;
+
+  // OS saves YMM (bits 1, 2) and ZMM/opmask (bits 5, 6, 7) registers
+  const unsigned long long xcr0 = _xgetbv(0);
+
+  __cpuidex(info, 7, 0);
+  features.avx2   = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x06) == 0x06;
+  features.avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+#else
+  __builtin_cpu_init();
+  features.avx2   = __builtin_cpu_supports("avx2");
+  features.avx512 = __builtin_cpu_supports("avx512f");
+#endif
+  return features;
+}
+
+const CpuFeatures& getCpuFeatures()
+{
+  static const CpuFeatures features = queryCpuFeatures();
+  return features;
+}
+}  // namespace
+
+bool cpuSupportsAvx2()
+{
+  return getCpuFeatures().avx2;
+}
+
+bool cpuSupportsAvx512()
+{
+  return getCpuFeatures().avx512;
+}
+#else
+bool cpuSupportsAvx2()
+{
+  return false;
+}
+
+bool cpuSupportsAvx512()
+{
+  return false;
+}
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+// Instruction sets usable by the CPU evaluators (CPU and OS support)
+bool cpuSupportsAvx2();
+bool cpuSupportsAvx512();
+
+// MSVC allows intrinsics in any function, GCC/Clang need the target attribute
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CPU_TARGET_AVX2
+#define CPU_TARGET_AVX512
+#else
+#define CPU_TARGET_AVX2 __attribute__((target("avx2")))
+#define CPU_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+// SIMD paths must not contract mul + add into FMA to match their scalar counterparts
+// The build compiles Evaluators/*.cpp with -ffp-contract=off (GCC and Clang), this also covers inline functions of
+// the headers (glm, intersectTriangle). The attribute and the pragma keep it when a file is built without the flag.
+// GCC contracts by default when FMA is available (AVX-512, -march=native), Clang within an expression
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#define CPU_NO_FP_CONTRACT
+#elif defined(__GNUC__)
+#define CPU_NO_FP_CONTRACT __attribute__((optimize("fp-contract=off")))
+#else
+#define CPU_NO_FP_CONTRACT
+#endif
@@ -0,0 +1,256 @@
+#include "CpuRasterEvaluator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+}  // namespace
+
+CpuRasterEvaluator::CpuRasterEvaluator(const std::vector<openstl::Triangle>& triangles, RasterKernelType kernel, unsigned int threadCount)
+    : workerPool(threadCount)
+{
+  if(!verifyRasterKernel(kernel))
+  {
+    std::cerr << "Raster kernel " << rasterKernelToString(kernel) << " doesn't match the scalar path, using scalar\n";
+    kernel = RasterKernelType::Scalar;
+  }
+  rasterKernelType = kernel;
+  rasterKernel     = getRasterKernel(kernel);
+
+  vertices.reserve(triangles.size() * 3);
+  for(const auto& triangle : triangles)
+  {
+    vertices.push_back(triangle.v0);
+    vertices.push_back(triangle.v1);
+    vertices.push_back(triangle.v2);
+  }
+  rasterVertices.resize(vertices.size());
+  triangleTiles.resize(triangles.size());
+  binTriangles.reserve(triangles.size());
+
+  tileBuffers.resize(workerPool.getThreadCount(), std::vector<float>(TILE_SIZE * TILE_SIZE));
+}
+
+float CpuRasterEvaluator::evaluate(const VolumeEvaluationView& view)
+{
+  if(view.resolution.x < 2 || view.resolution.y < 2)
+    return 0;
+
+  // 1) transform to raster space
+  auto start = Clock::now();
+  transformVertices(view);
+  timings.transformMs += elapsedMs(start);
+
+  // 2) bin triangles into tiles
+  start = Clock::now();
+  depthMap.resize(view.resolution.x, view.resolution.y);
+  tilesX = (view.resolution.x + TILE_SIZE - 1) / TILE_SIZE;
+  tilesY = (view.resolution.y + TILE_SIZE - 1) / TILE_SIZE;
+  binTrianglesToTiles();
+  timings.binningMs += elapsedMs(start);
+
+  // 3) rasterize tiles, every tile writes all of its columns
+  start = Clock::now();
+  const uint32_t tileCount = tilesX * tilesY;
+  tileTimings.assign(tileCount, 0.0f);
+  workerPool.parallelFor(tileCount, [this](uint32_t tileIndex, unsigned int workerIndex) {
+    auto tileStart = Clock::now();
+    rasterizeTile(tileIndex, tileBuffers[workerIndex].data());
+    tileTimings[tileIndex] = std::chrono::duration<float, std::micro>(Clock::now() - tileStart).count();
+  });
+  timings.rasterMs += elapsedMs(start);
+
+  for(uint32_t tile = 0; tile < tileCount; ++tile)
+  {
+    if(binOffsets[tile] == binOffsets[tile + 1])
+      continue;
+    timings.tiles++;
+    timings.tileTotalUs += tileTimings[tile];
+    timings.tileMaxUs = std::max(timings.tileMaxUs, (double)tileTimings[tile]);
+  }
+
+  // 4) integrate and sum
+  start        = Clock::now();
+  float volume = integrateDepthMap(depthMap, view.getCellSize(), workerPool);
+  timings.integrateMs += elapsedMs(start);
+
+  timings.evaluations++;
+  return volume;
+}
+
+void CpuRasterEvaluator::printStats() const
+{
+  if(timings.evaluations == 0)
+    return;
+
+  const double evaluations = (double)timings.evaluations;
+  std::cout << "[CPU raster] evaluations: " << timings.evaluations << ", threads: " << workerPool.getThreadCount()
+            << ", kernel: " << rasterKernelToString(rasterKernelType) << "\n";
+  std::cout << "[CPU raster] per evaluation (ms): transform " << timings.transformMs / evaluations << ", binning "
+            << timings.binningMs / evaluations << ", raster " << timings.rasterMs / evaluations << ", integrate "
+            << timings.integrateMs / evaluations << "\n";
+  if(timings.tiles > 0)
+  {
+    std::cout << "[CPU raster] tiles: " << timings.tiles << ", mean tile " << timings.tileTotalUs / (double)timings.tiles
+              << " us, max tile " << timings.tileMaxUs << " us\n";
+  }
+}
+
+void CpuRasterEvaluator::transformVertices(const VolumeEvaluationView& view)
+{
+  const glm::mat3 rotation(view.viewMatrix);
+  const glm::vec2 cellSize = view.getCellSize();
+
+  const uint32_t chunkCount  = workerPool.getThreadCount();
+  const size_t   vertexCount = vertices.size();
+  workerPool.parallelFor(chunkCount, [&](uint32_t chunk, unsigned int) {
+    size_t begin = vertexCount * chunk / chunkCount;
+    size_t end   = vertexCount * (chunk + 1) / chunkCount;
+    for(size_t i = begin; i < end; ++i)
+    {
+      glm::vec3 v = rotation * vertices[i];
+
+      // Column (0, 0) is at (aabbMin.x, aabbMax.y), see orthoRH_ZO in updateSceneBuffer
+      // Height matches (1 - depth) * (aabbMax.z - aabbMin.z) of the fragment shader
+      rasterVertices[i] = {(v.x - view.aabbMin.x) / cellSize.x, (view.aabbMax.y - v.y) / cellSize.y, v.z - view.aabbMin.z};
+    }
+  });
+}
+
+void CpuRasterEvaluator::binTrianglesToTiles()
+{
+  const uint32_t chunkCount    = workerPool.getThreadCount();
+  const uint32_t tileCount     = tilesX * tilesY;
+  const uint32_t triangleCount = (uint32_t)triangleTiles.size();
+  const float    lastColumn    = float(depthMap.width - 1);
+  const float    lastRow       = float(depthMap.height - 1);
+
+  binCounts.assign(size_t(chunkCount) * tileCount, 0);
+  binOffsets.assign(tileCount + 1, 0);
+
+  // Pass 1: tile range of every triangle, count triangles per chunk and tile
+  workerPool.parallelFor(chunkCount, [&](uint32_t chunk, unsigned int) {
+    uint32_t  begin  = uint32_t(uint64_t(triangleCount) * chunk / chunkCount);
+    uint32_t  end    = uint32_t(uint64_t(triangleCount) * (chunk + 1) / chunkCount);
+    uint32_t* counts = binCounts.data() + size_t(chunk) * tileCount;
+
+    for(uint32_t t = begin; t < end; ++t)
+    {
+      const glm::vec3& v0 = rasterVertices[t * 3];
+      const glm::vec3& v1 = rasterVertices[t * 3 + 1];
+      const glm::vec3& v2 = rasterVertices[t * 3 + 2];
+
+      TriangleTiles& tiles = triangleTiles[t];
+      tiles                = {1, 1, 0, 0};  // empty
+
+      // Sample points covered by the bounding box
+      float minX = std::max(std::ceil(std::min({v0.x, v1.x, v2.x})), 0.0f);
+      float maxX = std::min(std::floor(std::max({v0.x, v1.x, v2.x})), lastColumn);
+      float minY = std::max(std::ceil(std::min({v0.y, v1.y, v2.y})), 0.0f);
+      float maxY = std::min(std::floor(std::max({v0.y, v1.y, v2.y})), lastRow);
+      if(minX > maxX || minY > maxY)
+        continue;
+
+      // Degenerate triangle, rasterizer doesn't produce fragments
+      float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+      if(area == 0.0f)
+        continue;
+
+      tiles = {uint16_t(uint32_t(minX) / TILE_SIZE), uint16_t(uint32_t(minY) / TILE_SIZE),
+               uint16_t(uint32_t(maxX) / TILE_SIZE), uint16_t(uint32_t(maxY) / TILE_SIZE)};
+      for(uint32_t ty = tiles.minY; ty <= tiles.maxY; ++ty)
+        for(uint32_t tx = tiles.minX; tx <= tiles.maxX; ++tx)
+          counts[ty * tilesX + tx]++;
+    }
+  });
+
+  // Prefix sum, tile major so that the triangles of one tile are contiguous
+  // Counts become write cursors of every chunk
+  uint32_t offset = 0;
+  for(uint32_t tile = 0; tile < tileCount; ++tile)
+  {
+    binOffsets[tile] = offset;
+    for(uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+      uint32_t& count = binCounts[size_t(chunk) * tileCount + tile];
+      uint32_t  start = offset;
+      offset += count;
+      count = start;
+    }
+  }
+  binOffsets[tileCount] = offset;
+  binTriangles.resize(offset);
+
+  // Pass 2: scatter triangle indices, chunk order keeps the result deterministic
+  workerPool.parallelFor(chunkCount, [&](uint32_t chunk, unsigned int) {
+    uint32_t  begin   = uint32_t(uint64_t(triangleCount) * chunk / chunkCount);
+    uint32_t  end     = uint32_t(uint64_t(triangleCount) * (chunk + 1) / chunkCount);
+    uint32_t* cursors = binCounts.data() + size_t(chunk) * tileCount;
+
+    for(uint32_t t = begin; t < end; ++t)
+    {
+      const TriangleTiles& tiles = triangleTiles[t];
+      for(uint32_t ty = tiles.minY; ty <= tiles.maxY; ++ty)
+        for(uint32_t tx = tiles.minX; tx <= tiles.maxX; ++tx)
+          binTriangles[cursors[ty * tilesX + tx]++] = t;
+    }
+  });
+}
+
+void CpuRasterEvaluator::rasterizeTile(uint32_t tileIndex, float* tileBuffer)
+{
+  const uint32_t tileX0 = (tileIndex % tilesX) * TILE_SIZE;
+  const uint32_t tileY0 = (tileIndex / tilesX) * TILE_SIZE;
+  const uint32_t tileW  = std::min(TILE_SIZE, depthMap.width - tileX0);
+  const uint32_t tileH  = std::min(TILE_SIZE, depthMap.height - tileY0);
+
+  const uint32_t binStart = binOffsets[tileIndex];
+  const uint32_t binEnd   = binOffsets[tileIndex + 1];
+
+  if(binStart == binEnd)
+  {
+    // Empty tile
+    for(uint32_t y = 0; y < tileH; ++y)
+      std::memset(depthMap.row(tileY0 + y) + tileX0, 0, tileW * sizeof(float));
+    return;
+  }
+
+  std::fill_n(tileBuffer, TILE_SIZE * TILE_SIZE, 0.0f);
+
+  // Tile bounds in raster space
+  const float tileMinX = float(tileX0);
+  const float tileMinY = float(tileY0);
+  const float tileMaxX = float(tileX0 + tileW - 1);
+  const float tileMaxY = float(tileY0 + tileH - 1);
+
+  for(uint32_t b = binStart; b < binEnd; ++b)
+  {
+    const uint32_t   t  = binTriangles[b];
+    const glm::vec3& v0 = rasterVertices[t * 3];
+    const glm::vec3& v1 = rasterVertices[t * 3 + 1];
+    const glm::vec3& v2 = rasterVertices[t * 3 + 2];
+
+    // Bounding box of sample points covered by the triangle, clipped to the tile
+    float minX = std::max(std::ceil(std::min({v0.x, v1.x, v2.x})), tileMinX);
+    float maxX = std::min(std::floor(std::max({v0.x, v1.x, v2.x})), tileMaxX);
+    float minY = std::max(std::ceil(std::min({v0.y, v1.y, v2.y})), tileMinY);
+    float maxY = std::min(std::floor(std::max({v0.y, v1.y, v2.y})), tileMaxY);
+    if(minX > maxX || minY > maxY)
+      continue;
+
+    rasterKernel(&rasterVertices[t * 3], {minX, maxX, minY, maxY}, tileBuffer, TILE_SIZE, tileX0, tileY0);
+  }
+
+  // Write the tile to the depth map
+  for(uint32_t y = 0; y < tileH; ++y)
+    std::memcpy(depthMap.row(tileY0 + y) + tileX0, tileBuffer + y * TILE_SIZE, tileW * sizeof(float));
+}
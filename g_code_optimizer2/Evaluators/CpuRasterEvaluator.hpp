@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+
+#include "VolumeEvaluator.hpp"
+#include "DepthMap.hpp"
+#include "RasterKernel.hpp"
+#include "WorkerPool.hpp"
+#include "stl.h"
+
+// CPU implementation of the raster pipeline
+// 1) rasterize triangles into a depth map (volume_calculation_raster.slang)
+// 2) integrate the depth map (volume_integrate.slang)
+// 3) sum the integrated cells (volumesum_compute.slang)
+//
+// Rasterization is tile binned:
+// - triangles are binned into screen tiles (two passes, counting + scatter)
+// - tiles are rasterized in parallel into per-worker tile buffers, then copied to the depth map
+// - triangles are rasterized by a SIMD kernel selected at runtime (RasterKernel.hpp)
+class CpuRasterEvaluator : public VolumeEvaluator
+{
+public:
+  // 64 * 64 floats = 16 KB per tile buffer, fits in L1/L2
+  static constexpr uint32_t TILE_SIZE = 64;
+
+  // Timings accumulated over all evaluations
+  struct Timings
+  {
+    uint64_t evaluations = 0;
+    uint64_t tiles       = 0;  // rasterized (non empty) tiles
+    double   transformMs = 0;
+    double   binningMs   = 0;
+    double   rasterMs    = 0;
+    double   integrateMs = 0;
+    double   tileTotalUs = 0;  // sum of all tile times (all workers)
+    double   tileMaxUs   = 0;  // slowest tile
+  };
+
+  // kernel is checked against the scalar path, falls back to scalar on mismatch
+  // threadCount = 0 uses all hardware threads
+  CpuRasterEvaluator(const std::vector<openstl::Triangle>& triangles,
+                     RasterKernelType                      kernel      = detectRasterKernel(),
+                     unsigned int                          threadCount = 0);
+
+  float evaluate(const VolumeEvaluationView& view) override;
+  void  printStats() const override;
+
+  const DepthMap& getDepthMap() const { return depthMap; }
+
+  // Time of every tile of the last evaluation in microseconds (0 for empty tiles)
+  const std::vector<float>& getLastTileTimings() const { return tileTimings; }
+  const Timings&            getTimings() const { return timings; }
+  RasterKernelType          getRasterKernelType() const { return rasterKernelType; }
+
+private:
+  // Range of tiles touched by a triangle, empty when tileMin > tileMax
+  struct TriangleTiles
+  {
+    uint16_t minX, minY, maxX, maxY;
+  };
+
+  // Triangle corners, 3 per triangle
+  std::vector<glm::vec3> vertices;
+  // Corners in raster space: x, y in columns, z is support height above aabbMin.z
+  std::vector<glm::vec3> rasterVertices;
+
+  // Binning
+  uint32_t                   tilesX = 0;
+  uint32_t                   tilesY = 0;
+  std::vector<TriangleTiles> triangleTiles;
+  std::vector<uint32_t>      binCounts;     // [chunk][tile] triangle count, then write cursor
+  std::vector<uint32_t>      binOffsets;    // [tile], size tileCount + 1
+  std::vector<uint32_t>      binTriangles;  // triangle indices sorted by tile
+
+  // Output
+  DepthMap                        depthMap;
+  std::vector<std::vector<float>> tileBuffers;  // [worker]
+  std::vector<float>              tileTimings;  // [tile]
+
+  RasterKernelType rasterKernelType = RasterKernelType::Scalar;
+  RasterTriangleFn rasterKernel     = rasterTriangleScalar;
+
+  WorkerPool workerPool;
+  Timings    timings;
+
+  void transformVertices(const VolumeEvaluationView& view);
+  void binTrianglesToTiles();
+  void rasterizeTile(uint32_t tileIndex, float* tileBuffer);
+};
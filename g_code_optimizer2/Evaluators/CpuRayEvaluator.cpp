@@ -0,0 +1,191 @@
+#include "CpuRayEvaluator.hpp"
+#include "CpuFeatures.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+}  // namespace
+
+CpuRayEvaluator::Traversal CpuRayEvaluator::defaultTraversal()
+{
+  return cpuSupportsAvx2() ? Traversal::Packet : Traversal::Single;
+}
+
+const char* CpuRayEvaluator::traversalToString(Traversal traversal)
+{
+  return traversal == Traversal::Packet ? "packet" : "single";
+}
+
+CpuRayEvaluator::CpuRayEvaluator(const std::vector<openstl::Triangle>& triangles, Traversal requestedTraversal, unsigned int threadCount)
+    : bvh(triangles)
+    , traversal(requestedTraversal)
+    , workerPool(threadCount)
+{
+#if defined(_M_X64) || defined(__x86_64__)
+  if(traversal == Traversal::Packet && !cpuSupportsAvx2())
+    traversal = Traversal::Single;
+#endif
+
+  hitBuffers.resize(workerPool.getThreadCount() * RayPacket::SIZE);
+  hitCounts.resize(workerPool.getThreadCount());
+}
+
+float CpuRayEvaluator::evaluate(const VolumeEvaluationView& view)
+{
+  if(view.resolution.x < 2 || view.resolution.y < 2)
+    return 0;
+
+  auto start = Clock::now();
+  depthMap.resize(view.resolution.x, view.resolution.y);
+  std::fill(hitCounts.begin(), hitCounts.end(), 0);
+
+  // Rays are traced in model space, view space is rotation only
+  const glm::mat3 viewInv = glm::inverse(glm::mat3(view.viewMatrix));
+
+  // Columns only differ in their origin, one direction is shared by all rays (single and packet give the same hits)
+  const glm::vec3 direction = getColumnRay(view, viewInv, 0, 0).direction;
+
+  workerPool.parallelFor(view.resolution.y, [&](uint32_t y, unsigned int workerIndex) {
+    if(traversal == Traversal::Packet)
+      traceRowPacket(view, viewInv, direction, y, workerIndex);
+    else
+      traceRowSingle(view, viewInv, direction, y, workerIndex);
+  });
+  timings.traceMs += elapsedMs(start);
+
+  start        = Clock::now();
+  float volume = integrateDepthMap(depthMap, view.getCellSize(), workerPool);
+  timings.integrateMs += elapsedMs(start);
+
+  timings.evaluations++;
+  timings.rays += uint64_t(view.resolution.x) * view.resolution.y;
+  for(uint64_t count : hitCounts)
+    timings.hits += count;
+  return volume;
+}
+
+CpuRayEvaluator::ColumnRay CpuRayEvaluator::getColumnRay(const VolumeEvaluationView& view, const glm::mat3& viewInv, uint32_t x, uint32_t y)
+{
+  // Same column position as rgenMain (launch y is flipped)
+  glm::vec2 launchSize  = glm::vec2(view.resolution - 1u);
+  glm::vec2 launchID    = glm::vec2(float(x), float(view.resolution.y - y - 1));
+  glm::vec2 pixelOffset = glm::vec2(view.aabbMin) + (glm::vec2(view.aabbMax) - glm::vec2(view.aabbMin)) * (launchID / launchSize);
+
+  glm::vec3 topWorld    = viewInv * glm::vec3(pixelOffset, view.aabbMax.z);
+  glm::vec3 bottomWorld = viewInv * glm::vec3(pixelOffset, view.aabbMin.z);
+  return {topWorld, glm::normalize(bottomWorld - topWorld), glm::length(bottomWorld - topWorld)};
+}
+
+void CpuRayEvaluator::traceRowSingle(const VolumeEvaluationView& view,
+                                     const glm::mat3&            viewInv,
+                                     const glm::vec3&            direction,
+                                     uint32_t                    y,
+                                     unsigned int                workerIndex)
+{
+  std::vector<RayHit>& hits = hitBuffers[workerIndex * RayPacket::SIZE];
+  float*               row  = depthMap.row(y);
+
+  for(uint32_t x = 0; x < view.resolution.x; ++x)
+  {
+    ColumnRay ray = getColumnRay(view, viewInv, x, y);
+
+    // First hit must be past origin offset + TMin
+    hits.clear();
+    bvh.intersectAll(ray.origin, direction, 2.0f * RAY_EPSILON, ray.length, hits);
+    hitCounts[workerIndex] += hits.size();
+
+    row[x] = accumulateHits(hits, ray.length);
+  }
+}
+
+void CpuRayEvaluator::traceRowPacket(const VolumeEvaluationView& view,
+                                     const glm::mat3&            viewInv,
+                                     const glm::vec3&            direction,
+                                     uint32_t                    y,
+                                     unsigned int                workerIndex)
+{
+  std::vector<RayHit>* hits = &hitBuffers[workerIndex * RayPacket::SIZE];
+  float*               row  = depthMap.row(y);
+
+  RayPacket packet;
+  for(uint32_t x0 = 0; x0 < view.resolution.x; x0 += RayPacket::SIZE)
+  {
+    packet.count = std::min(RayPacket::SIZE, view.resolution.x - x0);
+    for(uint32_t lane = 0; lane < RayPacket::SIZE; ++lane)
+    {
+      // Unused lanes repeat the last column and are masked out
+      ColumnRay ray        = getColumnRay(view, viewInv, x0 + std::min(lane, packet.count - 1), y);
+      packet.originX[lane] = ray.origin.x;
+      packet.originY[lane] = ray.origin.y;
+      packet.originZ[lane] = ray.origin.z;
+      packet.tMax[lane]    = ray.length;
+      hits[lane].clear();
+    }
+
+    bvh.intersectPacket(packet, direction, 2.0f * RAY_EPSILON, hits);
+
+    for(uint32_t lane = 0; lane < packet.count; ++lane)
+    {
+      hitCounts[workerIndex] += hits[lane].size();
+      row[x0 + lane] = accumulateHits(hits[lane], packet.tMax[lane]);
+    }
+  }
+}
+
+float CpuRayEvaluator::accumulateHits(std::vector<RayHit>& hits, float columnLength)
+{
+  std::sort(hits.begin(), hits.end(), [](const RayHit& a, const RayHit& b) { return a.t < b.t; });
+
+  // Replays the TraceRay loop of rgenMain:
+  // - next ray starts RAY_EPSILON after the previous hit with TMin = RAY_EPSILON, closer hits are never seen
+  // - front face hit (not the first one) adds the distance to the previous hit (rchitMain)
+  // - miss after any hit adds the distance from the last hit to the bottom (rmissMain)
+  // - the loop stops after MAX_STEPS hits without the final miss
+  float    accumDistance = 0.0f;
+  float    prevT         = 0.0f;
+  float    nextMinT      = 2.0f * RAY_EPSILON;
+  uint32_t hitCount      = 0;
+  for(const RayHit& hit : hits)
+  {
+    if(hit.t < nextMinT)
+      continue;
+
+    if(hit.frontFace && hitCount != 0)
+      accumDistance += hit.t - prevT;
+
+    prevT    = hit.t;
+    nextMinT = hit.t + 2.0f * RAY_EPSILON;
+    if(++hitCount == MAX_STEPS)
+      return accumDistance;
+  }
+
+  if(hitCount > 0)
+    accumDistance += columnLength - prevT;
+  return accumDistance;
+}
+
+void CpuRayEvaluator::printStats() const
+{
+  if(timings.evaluations == 0)
+    return;
+
+  const double evaluations = (double)timings.evaluations;
+  std::cout << "[CPU ray] evaluations: " << timings.evaluations << ", threads: " << workerPool.getThreadCount()
+            << ", traversal: " << traversalToString(traversal) << ", BVH nodes: " << bvh.getNodes().size()
+            << ", depth: " << bvh.getDepth() << "\n";
+  std::cout << "[CPU ray] per evaluation (ms): trace " << timings.traceMs / evaluations << ", integrate "
+            << timings.integrateMs / evaluations << "\n";
+  if(timings.traceMs > 0.0)
+  {
+    std::cout << "[CPU ray] " << double(timings.rays) / (timings.traceMs * 1000.0) << " Mrays/s, "
+              << double(timings.hits) / double(std::max<uint64_t>(timings.rays, 1)) << " hits/ray\n";
+  }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+
+#include "VolumeEvaluator.hpp"
+#include "Bvh.hpp"
+#include "DepthMap.hpp"
+#include "WorkerPool.hpp"
+#include "stl.h"
+
+// CPU implementation of the ray tracing pipeline (volume_calculation_rtx.slang)
+// Every column is one ray from aabbMax.z to aabbMin.z (view space), all hits are collected in one BVH traversal
+// and accumulated with the same rules as the sequential TraceRay loop of the shader
+//
+// All columns are parallel (orthographic), with packet traversal 8 neighbouring columns of a row are traced together
+class CpuRayEvaluator : public VolumeEvaluator
+{
+public:
+  // Same constants as volume_calculation_rtx.slang
+  static constexpr uint32_t MAX_STEPS   = 64;
+  static constexpr float    RAY_EPSILON = 0.001f;  // origin offset and TMin after every hit
+
+  enum class Traversal
+  {
+    Single,  // one ray per column
+    Packet,  // RayPacket::SIZE columns per traversal (AVX2)
+  };
+
+  // Packet when supported by the CPU
+  static Traversal   defaultTraversal();
+  static const char* traversalToString(Traversal traversal);
+
+  // Timings accumulated over all evaluations
+  struct Timings
+  {
+    uint64_t evaluations = 0;
+    uint64_t rays        = 0;
+    uint64_t hits        = 0;  // all hits found by the traversal
+    double   traceMs     = 0;
+    double   integrateMs = 0;
+  };
+
+  // Packet traversal falls back to Single when AVX2 is not supported
+  // threadCount = 0 uses all hardware threads
+  CpuRayEvaluator(const std::vector<openstl::Triangle>& triangles,
+                  Traversal                             requestedTraversal = defaultTraversal(),
+                  unsigned int                          threadCount        = 0);
+
+  float evaluate(const VolumeEvaluationView& view) override;
+  void  printStats() const override;
+
+  const DepthMap& getDepthMap() const { return depthMap; }
+  const Bvh&      getBvh() const { return bvh; }
+  const Timings&  getTimings() const { return timings; }
+  Traversal       getTraversal() const { return traversal; }
+
+  // Accumulated distance of one column
+  // hits: all hits along the ray (t from the top of the column), sorted in place
+  // columnLength: distance from the top to the bottom of the column
+  static float accumulateHits(std::vector<RayHit>& hits, float columnLength);
+
+private:
+  // One column in model space
+  struct ColumnRay
+  {
+    glm::vec3 origin;
+    glm::vec3 direction;
+    float     length;
+  };
+
+  Bvh       bvh;
+  Traversal traversal = Traversal::Single;
+  DepthMap  depthMap;
+
+  std::vector<std::vector<RayHit>> hitBuffers;  // [worker][lane]
+  std::vector<uint64_t>            hitCounts;   // [worker]
+
+  WorkerPool workerPool;
+  Timings    timings;
+
+  static ColumnRay getColumnRay(const VolumeEvaluationView& view, const glm::mat3& viewInv, uint32_t x, uint32_t y);
+
+  void traceRowSingle(const VolumeEvaluationView& view,
+                      const glm::mat3&            viewInv,
+                      const glm::vec3&            direction,
+                      uint32_t                    y,
+                      unsigned int                workerIndex);
+  void traceRowPacket(const VolumeEvaluationView& view,
+                      const glm::mat3&            viewInv,
+                      const glm::vec3&            direction,
+                      uint32_t                    y,
+                      unsigned int                workerIndex);
+};
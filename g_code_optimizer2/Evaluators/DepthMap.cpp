@@ -0,0 +1,57 @@
+#include "DepthMap.hpp"
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+double integrateDepthMapRows(const DepthMap& depthMap, glm::vec2 areaSize, uint32_t rowStart, uint32_t rowEnd)
+{
+  if(depthMap.width < 2 || depthMap.height < 2)
+    return 0.0;
+
+  rowEnd = std::min(rowEnd, depthMap.height - 1);
+
+  const float cellArea = areaSize.x * areaSize.y;
+
+  double sum = 0.0;
+  for(uint32_t y = rowStart; y < rowEnd; ++y)
+  {
+    const float* top    = depthMap.row(y);
+    const float* bottom = depthMap.row(y + 1);
+
+    // Rows are summed separately to keep the float error similar to the GPU tree reduction
+    float rowSum = 0.0f;
+    for(uint32_t x = 0; x < depthMap.width - 1; ++x)
+    {
+      // 1/4 * (x_(i+1) + x_(i) + y_(i+1) + y_(i)) * width * height
+      rowSum += 0.25f * (top[x] + top[x + 1] + bottom[x] + bottom[x + 1]) * cellArea;
+    }
+    sum += rowSum;
+  }
+  return sum;
+}
+
+float integrateDepthMap(const DepthMap& depthMap, glm::vec2 areaSize)
+{
+  return (float)integrateDepthMapRows(depthMap, areaSize, 0, depthMap.height);
+}
+
+float integrateDepthMap(const DepthMap& depthMap, glm::vec2 areaSize, WorkerPool& workerPool)
+{
+  if(depthMap.width < 2 || depthMap.height < 2)
+    return 0.0f;
+
+  const uint32_t cellRows   = depthMap.height - 1;
+  const uint32_t chunkCount = std::min(workerPool.getThreadCount() * 4, cellRows);
+
+  std::vector<double> chunkSums(chunkCount);
+  workerPool.parallelFor(chunkCount, [&](uint32_t chunk, unsigned int) {
+    uint32_t rowStart = uint32_t(uint64_t(cellRows) * chunk / chunkCount);
+    uint32_t rowEnd   = uint32_t(uint64_t(cellRows) * (chunk + 1) / chunkCount);
+    chunkSums[chunk]  = integrateDepthMapRows(depthMap, areaSize, rowStart, rowEnd);
+  });
+
+  double sum = 0.0;
+  for(double chunkSum : chunkSums)
+    sum += chunkSum;
+  return (float)sum;
+}
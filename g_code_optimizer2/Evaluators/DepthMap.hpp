@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+class WorkerPool;
+
+// CPU counterpart of the eImgVolume GBuffer
+// One support height per column, row-major, 0 = empty column
+struct DepthMap
+{
+  uint32_t           width  = 0;
+  uint32_t           height = 0;
+  std::vector<float> values;
+
+  void reset(uint32_t newWidth, uint32_t newHeight)
+  {
+    width  = newWidth;
+    height = newHeight;
+    values.assign(size_t(width) * height, 0.0f);
+  }
+
+  // Resize without clearing, used when every column is written anyway
+  void resize(uint32_t newWidth, uint32_t newHeight)
+  {
+    width  = newWidth;
+    height = newHeight;
+    values.resize(size_t(width) * height);
+  }
+
+  float*       row(uint32_t y) { return values.data() + size_t(y) * width; }
+  const float* row(uint32_t y) const { return values.data() + size_t(y) * width; }
+};
+
+// Trapezoid integration (volume_integrate.slang) followed by the sum (volumesum_compute.slang)
+// (n) * (m) => (n-1) * (m-1) => 1
+float integrateDepthMap(const DepthMap& depthMap, glm::vec2 areaSize);
+
+// Integrates rows [rowStart, rowEnd) of the (n-1) * (m-1) cells, used to split the reduction
+double integrateDepthMapRows(const DepthMap& depthMap, glm::vec2 areaSize, uint32_t rowStart, uint32_t rowEnd);
+
+// Parallel integrateDepthMap, rows are split into chunks and the partial sums are added in fixed order (deterministic)
+float integrateDepthMap(const DepthMap& depthMap, glm::vec2 areaSize, WorkerPool& workerPool);
@@ -0,0 +1,62 @@
+#include "FacetSeeds.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+FacetSeeds::FacetSeeds(const std::vector<NormalBin>& bins)
+{
+  std::vector<glm::dvec3> normals;
+  normals.reserve(bins.size());
+  for(const auto& bin : bins)
+  {
+    totalArea += (float)bin.area;
+    normals.push_back(glm::normalize(bin.normalSum));
+  }
+
+  // Members of a cluster are within the chord of CLUSTER_ANGLE, so their z differs by at most that
+  std::vector<size_t> byZ(bins.size());
+  std::iota(byZ.begin(), byZ.end(), size_t(0));
+  std::sort(byZ.begin(), byZ.end(), [&](size_t a, size_t b) { return normals[a].z < normals[b].z; });
+  std::vector<double> sortedZ;
+  sortedZ.reserve(byZ.size());
+  for(size_t index : byZ)
+    sortedZ.push_back(normals[index].z);
+
+  // Greedy clusters around the largest remaining bin
+  const double      minCos = std::cos(FacetSeeds::CLUSTER_ANGLE);
+  const double      chord  = 2.0 * std::sin(0.5 * FacetSeeds::CLUSTER_ANGLE);
+  std::vector<bool> assigned(bins.size(), false);
+  for(size_t i = 0; i < bins.size(); ++i)
+  {
+    if(assigned[i])
+      continue;
+
+    const glm::dvec3& center = normals[i];
+    NormalBin         cluster;
+    auto              first  = std::lower_bound(sortedZ.begin(), sortedZ.end(), center.z - chord) - sortedZ.begin();
+    auto              last   = std::upper_bound(sortedZ.begin(), sortedZ.end(), center.z + chord) - sortedZ.begin();
+    for(auto k = first; k < last; ++k)
+    {
+      const size_t j = byZ[k];
+      if(assigned[j] || glm::dot(normals[j], center) < minCos)
+        continue;
+      assigned[j] = true;
+      cluster.normalSum += bins[j].normalSum;
+      cluster.area += bins[j].area;
+    }
+    seeds.push_back({-glm::vec3(glm::normalize(cluster.normalSum)), (float)cluster.area});
+  }
+
+  std::stable_sort(seeds.begin(), seeds.end(), [](const Seed& a, const Seed& b) { return a.area > b.area; });
+  if(seeds.size() > MAX_SEEDS)
+    seeds.resize(MAX_SEEDS);
+}
+
+std::vector<glm::vec3> FacetSeeds::getDirections() const
+{
+  std::vector<glm::vec3> directions;
+  for(const auto& seed : seeds)
+    directions.push_back(seed.direction);
+  return directions;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "NormalBins.hpp"
+
+// Build directions putting a large flat face (or a cluster of almost coplanar facets) on the bed
+// Binned facet normals (binFacetNormals) are merged greedily (largest bin first) into clusters of normals within
+// CLUSTER_ANGLE of the cluster normal, only bins in the z window of the cluster normal are tested
+// Seeds are the clusters by decreasing area, the direction is the camera position (up) with the cluster facing down
+class FacetSeeds
+{
+public:
+  static constexpr float  CLUSTER_ANGLE = 0.087f;  // radians (5 degrees)
+  static constexpr size_t MAX_SEEDS     = 32;
+
+  struct Seed
+  {
+    glm::vec3 direction;  // up, the facets of the cluster face -direction
+    float     area;
+  };
+
+  // bins: sorted by decreasing area, cells smaller than CLUSTER_ANGLE
+  explicit FacetSeeds(const std::vector<NormalBin>& bins);
+
+  // Largest clusters first
+  const std::vector<Seed>& getSeeds() const { return seeds; }
+  std::vector<glm::vec3>   getDirections() const;
+
+  float getTotalArea() const { return totalArea; }
+
+private:
+  std::vector<Seed> seeds;
+  float             totalArea = 0;
+};
@@ -0,0 +1,69 @@
+#include "HullBound.hpp"
+
+#include <algorithm>
+
+namespace {
+std::vector<glm::vec3> triangleVertices(const std::vector<openstl::Triangle>& triangles)
+{
+  std::vector<glm::vec3> points;
+  points.reserve(triangles.size() * 3);
+  for(const auto& t : triangles)
+  {
+    points.push_back(t.v0);
+    points.push_back(t.v1);
+    points.push_back(t.v2);
+  }
+  return points;
+}
+}  // namespace
+
+HullBound::HullBound(const std::vector<openstl::Triangle>& triangles, AnalyticEvaluator::Metric metric)
+    : hull(triangleVertices(triangles))
+    , metric(metric)
+{
+  // Mesh volume (divergence theorem), same as AnalyticEvaluator
+  for(const auto& t : triangles)
+    meshVolume += double(glm::dot(glm::cross(t.v1 - t.v0, t.v2 - t.v0), t.v0)) / 6.0;
+
+  if(!hull.isValid())
+    return;
+
+  // Facet is on the hull if the hull has no point beyond its plane (either winding)
+  const float tolerance   = 4.0f * hull.getEpsilon();
+  uint32_t    startVertex = 0;
+  for(const auto& t : triangles)
+  {
+    glm::vec3   areaVector = 0.5f * glm::cross(t.v1 - t.v0, t.v2 - t.v0);
+    const float area       = glm::length(areaVector);
+    if(area <= 0.0f)
+      continue;
+
+    for(float side : {1.0f, -1.0f})
+    {
+      const glm::vec3 normal  = side * areaVector / area;
+      const float     support = hull.support(normal, startVertex);
+      if(std::min({glm::dot(normal, t.v0), glm::dot(normal, t.v1), glm::dot(normal, t.v2)}) >= support - tolerance)
+      {
+        areaVectors.push_back(normal * area);
+        centroids.push_back((t.v0 + t.v1 + t.v2) / 3.0f);
+        break;
+      }
+    }
+  }
+}
+
+float HullBound::lowerBound(const glm::vec3& up) const
+{
+  double bound = metric == AnalyticEvaluator::Metric::HeightField ? std::max(meshVolume, 0.0) : 0.0;
+  if(!hull.isValid())
+    return (float)bound;
+
+  const float bottom = -hull.support(-up);
+  for(size_t i = 0; i < areaVectors.size(); ++i)
+  {
+    const float projectedArea = glm::dot(areaVectors[i], up);
+    if(projectedArea < 0.0f)
+      bound += double(-projectedArea) * double(std::max(glm::dot(centroids[i], up) - bottom, 0.0f));
+  }
+  return (float)bound;
+}
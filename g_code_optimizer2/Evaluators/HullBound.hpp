@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "AnalyticEvaluator.hpp"
+#include "ConvexHull.hpp"
+#include "stl.h"
+
+// Lower bound of the volume for any build direction, from the convex hull of the mesh
+// A facet lying on the hull has nothing of the mesh on its outer side. When it faces down, the column below it
+// is empty down to the bottom (lowest hull vertex), so its full height needs support:
+//   bound = sum over downward hull facets (projected area * height of the centroid above the bottom)
+// These columns don't overlap (the lower side of a convex body is a height field), and every evaluator
+// counts at least this much below the mesh. Metric::HeightField adds the mesh volume
+//
+// The bound is continuous, raster/ray results can be below it by their sampling error
+class HullBound
+{
+public:
+  HullBound(const std::vector<openstl::Triangle>& triangles, AnalyticEvaluator::Metric metric);
+
+  // up: view z in model space, the bottom is the lowest point along -up
+  float lowerBound(const glm::vec3& up) const;
+
+  const ConvexHull& getHull() const { return hull; }
+  size_t            getBoundaryFacetCount() const { return areaVectors.size(); }
+
+private:
+  ConvexHull                hull;
+  AnalyticEvaluator::Metric metric;
+  double                    meshVolume = 0;
+
+  // Facets on the hull, outward area vectors (cross / 2) and centroids
+  std::vector<glm::vec3> areaVectors;
+  std::vector<glm::vec3> centroids;
+};
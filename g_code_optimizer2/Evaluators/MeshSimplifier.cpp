@@ -0,0 +1,314 @@
+#include "MeshSimplifier.hpp"
+
+#include "include/hash_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+// Sum of weighted squared distances to planes, symmetric 4x4 matrix (upper triangle)
+struct Quadric
+{
+  double q[10]{};
+  double weight = 0;  // sum of the plane weights
+
+  void addPlane(const glm::dvec3& n, double d, double w)
+  {
+    q[0] += w * n.x * n.x;
+    q[1] += w * n.x * n.y;
+    q[2] += w * n.x * n.z;
+    q[3] += w * n.x * d;
+    q[4] += w * n.y * n.y;
+    q[5] += w * n.y * n.z;
+    q[6] += w * n.y * d;
+    q[7] += w * n.z * n.z;
+    q[8] += w * n.z * d;
+    q[9] += w * d * d;
+    weight += w;
+  }
+
+  Quadric& operator+=(const Quadric& other)
+  {
+    for(int i = 0; i < 10; ++i)
+      q[i] += other.q[i];
+    weight += other.weight;
+    return *this;
+  }
+
+  // Weighted RMS distance of p to the planes
+  double error(const glm::dvec3& p) const
+  {
+    if(weight <= 0.0)
+      return 0.0;
+    const double x = p.x, y = p.y, z = p.z;
+    const double sum = q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x + q[4] * y * y
+                       + 2.0 * q[5] * y * z + 2.0 * q[6] * y + q[7] * z * z + 2.0 * q[8] * z + q[9];
+    return std::sqrt(std::max(sum, 0.0) / weight);
+  }
+};
+
+// Edge collapse candidate, stale when a vertex was changed after it was queued
+struct Collapse
+{
+  double   error;
+  uint32_t keep;
+  uint32_t remove;
+  uint32_t keepVersion;
+  uint32_t removeVersion;
+
+  bool operator>(const Collapse& other) const { return error > other.error; }
+};
+
+uint64_t edgeKey(uint32_t a, uint32_t b)
+{
+  if(a > b)
+    std::swap(a, b);
+  return (uint64_t(a) << 32) | b;
+}
+
+struct PositionHash
+{
+  size_t operator()(const glm::vec3& p) const { return (size_t)hashBytes(&p, sizeof(p)); }
+};
+
+glm::dvec3 faceCross(const std::vector<glm::dvec3>& positions, const std::array<uint32_t, 3>& face)
+{
+  return glm::cross(positions[face[1]] - positions[face[0]], positions[face[2]] - positions[face[0]]);
+}
+}  // namespace
+
+MeshSimplifier::MeshSimplifier(const std::vector<openstl::Triangle>& triangles)
+{
+  std::unordered_map<glm::vec3, uint32_t, PositionHash> indices;
+  indices.reserve(triangles.size());
+
+  auto weld = [&](glm::vec3 p) {
+    p += glm::vec3(0.0f);  // -0 and +0 hash the same
+    auto [it, inserted] = indices.try_emplace(p, (uint32_t)vertices.size());
+    if(inserted)
+      vertices.push_back(glm::dvec3(p));
+    return it->second;
+  };
+
+  faces.reserve(triangles.size());
+  for(const auto& t : triangles)
+  {
+    std::array<uint32_t, 3> face{weld(t.v0), weld(t.v1), weld(t.v2)};
+    if(face[0] != face[1] && face[1] != face[2] && face[0] != face[2])
+      faces.push_back(face);
+  }
+}
+
+std::vector<MeshSimplifier::Level> MeshSimplifier::simplify(const std::vector<size_t>& targetTriangles, float maxError) const
+{
+  const uint32_t vertexCount = (uint32_t)vertices.size();
+
+  std::vector<glm::dvec3>              positions = vertices;
+  std::vector<std::array<uint32_t, 3>> work      = faces;
+  std::vector<bool>                    faceAlive(work.size(), true);
+  size_t                               liveFaces = work.size();
+
+  std::vector<std::vector<uint32_t>> vertexFaces(vertexCount);
+  std::unordered_map<uint64_t, uint32_t> edgeUses;
+  for(uint32_t f = 0; f < work.size(); ++f)
+  {
+    for(int i = 0; i < 3; ++i)
+    {
+      vertexFaces[work[f][i]].push_back(f);
+      edgeUses[edgeKey(work[f][i], work[f][(i + 1) % 3])]++;
+    }
+  }
+
+  // Planes of the original facets, open boundaries are held by planes through the edge perpendicular to the facet
+  // Vertices on non-manifold edges are never moved
+  std::vector<Quadric> quadrics(vertexCount);
+  std::vector<uint8_t> boundary(vertexCount, 0);
+  std::vector<uint8_t> locked(vertexCount, 0);
+  for(const auto& face : work)
+  {
+    const glm::dvec3 cross  = faceCross(positions, face);
+    const double     length = glm::length(cross);
+    for(int i = 0; i < 3; ++i)
+    {
+      const uint32_t a    = face[i];
+      const uint32_t b    = face[(i + 1) % 3];
+      const uint32_t uses = edgeUses[edgeKey(a, b)];
+      if(uses > 2)
+        locked[a] = locked[b] = 1;
+      if(uses != 1 || length <= 0.0)
+        continue;
+
+      const glm::dvec3 edge   = positions[b] - positions[a];
+      const glm::dvec3 normal = glm::normalize(glm::cross(edge, cross / length));
+      const double     weight = BOUNDARY_WEIGHT * glm::dot(edge, edge);
+      quadrics[a].addPlane(normal, -glm::dot(normal, positions[a]), weight);
+      quadrics[b].addPlane(normal, -glm::dot(normal, positions[a]), weight);
+      boundary[a] = boundary[b] = 1;
+    }
+
+    if(length <= 0.0)
+      continue;
+    const glm::dvec3 normal = cross / length;
+    for(uint32_t v : face)
+      quadrics[v].addPlane(normal, -glm::dot(normal, positions[face[0]]), 0.5 * length);
+  }
+
+  std::vector<uint32_t> version(vertexCount, 0);
+  std::vector<bool>     vertexAlive(vertexCount, true);
+
+  std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+  auto pushEdge = [&](uint32_t a, uint32_t b) {
+    if(locked[a] || locked[b])
+      return;
+    Quadric quadric = quadrics[a];
+    quadric += quadrics[b];
+    const double errorA = quadric.error(positions[a]);
+    const double errorB = quadric.error(positions[b]);
+    if(errorA <= errorB)
+      queue.push({errorA, a, b, version[a], version[b]});
+    else
+      queue.push({errorB, b, a, version[b], version[a]});
+  };
+  for(const auto& [key, uses] : edgeUses)
+    pushEdge(uint32_t(key >> 32), uint32_t(key));
+
+  std::vector<uint32_t> neighbours;
+  std::vector<uint32_t> otherNeighbours;
+  auto collectNeighbours = [&](uint32_t v, std::vector<uint32_t>& out) {
+    out.clear();
+    for(uint32_t f : vertexFaces[v])
+    {
+      if(!faceAlive[f])
+        continue;
+      for(uint32_t u : work[f])
+        if(u != v)
+          out.push_back(u);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+  };
+
+  // Link condition (the common neighbours are the apexes of the shared facets) and no flipped facets
+  auto canCollapse = [&](uint32_t keep, uint32_t remove) {
+    int sharedFaces = 0;
+    for(uint32_t f : vertexFaces[remove])
+      if(faceAlive[f] && std::find(work[f].begin(), work[f].end(), keep) != work[f].end())
+        sharedFaces++;
+
+    collectNeighbours(keep, neighbours);
+    collectNeighbours(remove, otherNeighbours);
+    size_t common = 0;
+    for(uint32_t u : otherNeighbours)
+      common += std::binary_search(neighbours.begin(), neighbours.end(), u);
+    if((int)common != sharedFaces)
+      return false;
+
+    // Interior edge between two boundaries would pinch the surface
+    if(boundary[keep] && boundary[remove] && sharedFaces != 1)
+      return false;
+
+    // Closed components smaller than a tetrahedron
+    if(neighbours.size() + otherNeighbours.size() - common - 2 < 3)
+      return false;
+
+    for(uint32_t f : vertexFaces[remove])
+    {
+      if(!faceAlive[f] || std::find(work[f].begin(), work[f].end(), keep) != work[f].end())
+        continue;
+
+      std::array<uint32_t, 3> moved = work[f];
+      std::replace(moved.begin(), moved.end(), remove, keep);
+
+      const glm::dvec3 before = faceCross(positions, work[f]);
+      const glm::dvec3 after  = faceCross(positions, moved);
+      const double     lengthBefore = glm::length(before);
+      const double     lengthAfter  = glm::length(after);
+      if(lengthAfter <= 0.0)
+        return false;
+      if(lengthBefore > 0.0 && glm::dot(before, after) < MIN_FLIP_COS * lengthBefore * lengthAfter)
+        return false;
+    }
+    return true;
+  };
+
+  std::vector<Level> levels;
+  double             largestError = 0;
+  auto               snapshot     = [&]() {
+    Level level;
+    level.error = (float)largestError;
+    level.triangles.reserve(liveFaces);
+    for(uint32_t f = 0; f < work.size(); ++f)
+    {
+      if(!faceAlive[f])
+        continue;
+      openstl::Triangle t{};
+      t.v0     = glm::vec3(positions[work[f][0]]);
+      t.v1     = glm::vec3(positions[work[f][1]]);
+      t.v2     = glm::vec3(positions[work[f][2]]);
+      t.normal = glm::vec3(glm::normalize(faceCross(positions, work[f])));
+      level.triangles.push_back(t);
+    }
+    levels.push_back(std::move(level));
+  };
+
+  while(levels.size() < targetTriangles.size())
+  {
+    if(liveFaces <= targetTriangles[levels.size()])
+    {
+      snapshot();
+      continue;
+    }
+    if(queue.empty())
+      break;
+
+    const Collapse c = queue.top();
+    queue.pop();
+    if(!vertexAlive[c.keep] || !vertexAlive[c.remove] || version[c.keep] != c.keepVersion
+       || version[c.remove] != c.removeVersion)
+      continue;
+    if(c.error > maxError)
+      break;
+    if(!canCollapse(c.keep, c.remove))
+      continue;
+
+    // Facets of the edge disappear, the others move to the kept vertex
+    for(uint32_t f : vertexFaces[c.remove])
+    {
+      if(!faceAlive[f])
+        continue;
+      if(std::find(work[f].begin(), work[f].end(), c.keep) != work[f].end())
+      {
+        faceAlive[f] = false;
+        liveFaces--;
+        continue;
+      }
+      std::replace(work[f].begin(), work[f].end(), c.remove, c.keep);
+      vertexFaces[c.keep].push_back(f);
+    }
+    auto& keepFaces = vertexFaces[c.keep];
+    keepFaces.erase(std::remove_if(keepFaces.begin(), keepFaces.end(), [&](uint32_t f) { return !faceAlive[f]; }),
+                    keepFaces.end());
+    vertexFaces[c.remove].clear();
+    vertexAlive[c.remove] = false;
+
+    quadrics[c.keep] += quadrics[c.remove];
+    boundary[c.keep] |= boundary[c.remove];
+    version[c.keep]++;
+    largestError = std::max(largestError, c.error);
+
+    collectNeighbours(c.keep, neighbours);
+    for(uint32_t u : neighbours)
+      pushEdge(c.keep, u);
+  }
+
+  // Error bound reached, the remaining levels can't be simplified further
+  if(levels.size() < targetTriangles.size())
+  {
+    snapshot();
+    while(levels.size() < targetTriangles.size())
+      levels.push_back(levels.back());
+  }
+  return levels;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "stl.h"
+
+// Quadric error edge collapse (Garland-Heckbert) for the levels of detail of the mesh
+// Collapsed vertices keep the position of one endpoint, so the simplified mesh stays inside the AABB and
+// the convex hull of the original. Collapses that flip a facet or break the manifold are rejected.
+//
+// Error of a collapse is the area weighted RMS distance of the kept position to the planes of the original facets
+// around both vertices, boundary edges are held by perpendicular planes
+class MeshSimplifier
+{
+public:
+  static constexpr double BOUNDARY_WEIGHT = 10.0;  // weight of the planes keeping open boundaries in place
+  static constexpr double MIN_FLIP_COS    = 0.2;   // min cos between the facet normal before and after a collapse
+
+  struct Level
+  {
+    std::vector<openstl::Triangle> triangles;
+    float                          error = 0;  // largest collapse error (model units)
+  };
+
+  explicit MeshSimplifier(const std::vector<openstl::Triangle>& triangles);
+
+  // One level per target (decreasing triangle counts), all from a single sequence of collapses
+  // Collapsing stops when the last target is reached or the next collapse would exceed maxError (model units),
+  // the remaining levels are then the same mesh
+  std::vector<Level> simplify(const std::vector<size_t>& targetTriangles, float maxError) const;
+
+  size_t getVertexCount() const { return vertices.size(); }
+  size_t getFaceCount() const { return faces.size(); }
+
+private:
+  std::vector<glm::dvec3>              vertices;  // welded
+  std::vector<std::array<uint32_t, 3>> faces;     // degenerate facets are dropped
+};
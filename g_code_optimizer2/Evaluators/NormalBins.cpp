@@ -0,0 +1,75 @@
+#include "NormalBins.hpp"
+#include "WorkerPool.hpp"
+
+#include "include/hash_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+struct BinKey
+{
+  int32_t x, y, z;
+
+  bool operator==(const BinKey& other) const = default;
+};
+
+struct BinKeyHash
+{
+  size_t operator()(const BinKey& key) const { return (size_t)hashBytes(&key, sizeof(key)); }
+};
+
+using BinMap = std::unordered_map<BinKey, NormalBin, BinKeyHash>;
+}  // namespace
+
+std::vector<NormalBin> binFacetNormals(const std::vector<openstl::Triangle>& triangles, float cellSize)
+{
+  WorkerPool          workerPool;
+  const uint32_t      chunkCount = std::min<uint32_t>(workerPool.getThreadCount() * 4, (uint32_t)triangles.size());
+  std::vector<BinMap> chunkBins(chunkCount);
+  workerPool.parallelFor(chunkCount, [&](uint32_t chunk, unsigned int) {
+    const size_t start = triangles.size() * chunk / chunkCount;
+    const size_t end   = triangles.size() * (chunk + 1) / chunkCount;
+    for(size_t i = start; i < end; ++i)
+    {
+      const auto&     t     = triangles[i];
+      const glm::vec3 cross = glm::cross(t.v1 - t.v0, t.v2 - t.v0);
+      const float     area  = 0.5f * glm::length(cross);
+      if(area <= 0.0f)
+        continue;
+
+      const glm::vec3 normal = cross / (2.0f * area);
+      const BinKey    key{(int32_t)std::floor(normal.x / cellSize), (int32_t)std::floor(normal.y / cellSize),
+                       (int32_t)std::floor(normal.z / cellSize)};
+      NormalBin&      bin = chunkBins[chunk][key];
+      bin.normalSum += glm::dvec3(normal) * double(area);
+      bin.area += area;
+    }
+  });
+
+  BinMap merged;
+  for(const auto& bins : chunkBins)
+  {
+    for(const auto& [key, bin] : bins)
+    {
+      NormalBin& target = merged[key];
+      target.normalSum += bin.normalSum;
+      target.area += bin.area;
+    }
+  }
+
+  std::vector<NormalBin> bins;
+  bins.reserve(merged.size());
+  for(const auto& [key, bin] : merged)
+    bins.push_back(bin);
+
+  // Ties by normal so the order doesn't depend on the hash map
+  std::sort(bins.begin(), bins.end(), [](const NormalBin& a, const NormalBin& b) {
+    if(a.area != b.area)
+      return a.area > b.area;
+    return std::tie(a.normalSum.x, a.normalSum.y, a.normalSum.z) < std::tie(b.normalSum.x, b.normalSum.y, b.normalSum.z);
+  });
+  return bins;
+}
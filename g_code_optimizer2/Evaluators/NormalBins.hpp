@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "stl.h"
+
+// Facet normals splatted onto a spherical grid (cells of a lattice around the unit sphere), weighted by area
+// One parallel pass over the triangles, every chunk fills its own bins, then they are merged
+// The bins are built once at load time and shared by FacetSeeds and OverhangProxy
+
+// Lattice cell of the shared bins, smaller than a facet cluster (FacetSeeds::CLUSTER_ANGLE)
+constexpr float NORMAL_BIN_SIZE = 0.03f;
+
+struct NormalBin
+{
+  glm::dvec3 normalSum{0.0};  // area weighted
+  double     area = 0;
+
+  glm::vec3 normal() const { return glm::vec3(glm::normalize(normalSum)); }
+};
+
+// Sorted by decreasing area (ties by normal), independent of the thread count
+std::vector<NormalBin> binFacetNormals(const std::vector<openstl::Triangle>& triangles, float cellSize);
@@ -0,0 +1,25 @@
+#include "OverhangProxy.hpp"
+
+#include <cmath>
+
+OverhangProxy::OverhangProxy(const std::vector<NormalBin>& bins, float overhangAngle)
+    : minDown(std::sin(overhangAngle))
+{
+  for(const auto& bin : bins)
+  {
+    normals.push_back(bin.normal());
+    areas.push_back((float)bin.area);
+  }
+}
+
+float OverhangProxy::evaluate(const glm::vec3& up) const
+{
+  float sum = 0;
+  for(size_t i = 0; i < normals.size(); ++i)
+  {
+    const float down = -glm::dot(normals[i], up);
+    if(down > minDown)
+      sum += areas[i] * down;
+  }
+  return sum;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "NormalBins.hpp"
+
+// Cheap proxy of the support volume: projected area of the overhanging facets
+//   proxy(up) = sum over facets (area * max(0, -n.up)) where -n.up > sin(overhangAngle)
+// The proxy of any direction is the histogram of the binned normals (binFacetNormals, built once at load time)
+// convolved with the overhang kernel (cost per direction is the bin count, not the facet count)
+//
+// Only a ranking: heights are ignored, and a face lying on the bed counts as overhang
+class OverhangProxy
+{
+public:
+  // overhangAngle: radians from the vertical, facets leaning further out need support
+  OverhangProxy(const std::vector<NormalBin>& bins, float overhangAngle);
+
+  // up: build direction in model space
+  float evaluate(const glm::vec3& up) const;
+
+  size_t getBinCount() const { return normals.size(); }
+
+private:
+  std::vector<glm::vec3> normals;  // mean normal of every bin
+  std::vector<float>     areas;
+  float                  minDown;  // sin(overhangAngle)
+};
@@ -0,0 +1,166 @@
+#include "RasterKernel.hpp"
+#include "CpuFeatures.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define RASTER_KERNEL_X64 1
+#endif
+
+CPU_NO_FP_CONTRACT void rasterTriangleScalar(const glm::vec3* corners, const RasterBounds& bounds, float* tileBuffer, uint32_t tileStride, uint32_t tileX0, uint32_t tileY0)
+{
+  const glm::vec3& v0 = corners[0];
+  const glm::vec3& v1 = corners[1];
+  const glm::vec3& v2 = corners[2];
+
+  // Edge functions, w0 is opposite to v0
+  const float area    = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+  const float sign    = area > 0.0f ? 1.0f : -1.0f;
+  const float invArea = 1.0f / area;
+
+  for(float y = bounds.minY; y <= bounds.maxY; y += 1.0f)
+  {
+    float* row = tileBuffer + (uint32_t(y) - tileY0) * tileStride;
+    for(float x = bounds.minX; x <= bounds.maxX; x += 1.0f)
+    {
+      float w0 = (v2.x - v1.x) * (y - v1.y) - (v2.y - v1.y) * (x - v1.x);
+      float w1 = (v0.x - v2.x) * (y - v2.y) - (v0.y - v2.y) * (x - v2.x);
+      float w2 = (v1.x - v0.x) * (y - v0.y) - (v1.y - v0.y) * (x - v0.x);
+
+      // Sample is inside (edges are inclusive, only the highest surface is kept anyway)
+      if(w0 * sign < 0.0f || w1 * sign < 0.0f || w2 * sign < 0.0f)
+        continue;
+
+      float height = (w0 * v0.z + w1 * v1.z + w2 * v2.z) * invArea;
+
+      // Depth test keeps the surface closest to the camera (= highest)
+      uint32_t column = uint32_t(x) - tileX0;
+      row[column]     = std::max(row[column], height);
+    }
+  }
+}
+
+bool isRasterKernelSupported(RasterKernelType type)
+{
+  switch(type)
+  {
+    case RasterKernelType::Scalar:
+      return true;
+#ifdef RASTER_KERNEL_X64
+    case RasterKernelType::Avx2:
+      return cpuSupportsAvx2();
+    case RasterKernelType::Avx512:
+      return cpuSupportsAvx512();
+#endif
+    default:
+      return false;
+  }
+}
+
+RasterKernelType detectRasterKernel()
+{
+  if(isRasterKernelSupported(RasterKernelType::Avx512))
+    return RasterKernelType::Avx512;
+  if(isRasterKernelSupported(RasterKernelType::Avx2))
+    return RasterKernelType::Avx2;
+  return RasterKernelType::Scalar;
+}
+
+RasterTriangleFn getRasterKernel(RasterKernelType type)
+{
+  switch(type)
+  {
+#ifdef RASTER_KERNEL_X64
+    case RasterKernelType::Avx2:
+      return rasterTriangleAvx2;
+    case RasterKernelType::Avx512:
+      return rasterTriangleAvx512;
+#endif
+    default:
+      return rasterTriangleScalar;
+  }
+}
+
+const char* rasterKernelToString(RasterKernelType type)
+{
+  switch(type)
+  {
+    case RasterKernelType::Avx2:
+      return "avx2";
+    case RasterKernelType::Avx512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+RasterKernelType selectRasterKernel(const std::string& name)
+{
+  if(name == "auto")
+    return detectRasterKernel();
+
+  for(RasterKernelType type : {RasterKernelType::Scalar, RasterKernelType::Avx2, RasterKernelType::Avx512})
+  {
+    if(name != rasterKernelToString(type))
+      continue;
+
+    if(!isRasterKernelSupported(type))
+      throw std::runtime_error("raster kernel " + name + " is not supported by this CPU");
+    return type;
+  }
+  throw std::runtime_error("unknown raster kernel (" + name + ")");
+}
+
+bool verifyRasterKernel(RasterKernelType type)
+{
+  if(type == RasterKernelType::Scalar)
+    return true;
+
+  constexpr uint32_t tileSize      = 64;
+  constexpr uint32_t triangleCount = 512;
+  const uint32_t     tileX0        = 3 * tileSize;
+  const uint32_t     tileY0        = 5 * tileSize;
+
+  std::vector<float> expected(tileSize * tileSize, 0.0f);
+  std::vector<float> actual(tileSize * tileSize, 0.0f);
+
+  RasterTriangleFn kernel = getRasterKernel(type);
+
+  // Fixed seed, triangles partially outside of the tile, some snapped to columns (edges through samples)
+  std::mt19937                          rng(1234);
+  std::uniform_real_distribution<float> position(-16.0f, float(tileSize) + 16.0f);
+  std::uniform_real_distribution<float> height(0.0f, 100.0f);
+
+  for(uint32_t t = 0; t < triangleCount; ++t)
+  {
+    glm::vec3 corners[3];
+    for(glm::vec3& corner : corners)
+    {
+      corner = {float(tileX0) + position(rng), float(tileY0) + position(rng), height(rng)};
+      if(t % 4 == 0)
+        corner = {std::round(corner.x), std::round(corner.y), corner.z};
+    }
+
+    const glm::vec3 &v0 = corners[0], &v1 = corners[1], &v2 = corners[2];
+    if((v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x) == 0.0f)
+      continue;
+
+    RasterBounds bounds;
+    bounds.minX = std::max(std::ceil(std::min({v0.x, v1.x, v2.x})), float(tileX0));
+    bounds.maxX = std::min(std::floor(std::max({v0.x, v1.x, v2.x})), float(tileX0 + tileSize - 1));
+    bounds.minY = std::max(std::ceil(std::min({v0.y, v1.y, v2.y})), float(tileY0));
+    bounds.maxY = std::min(std::floor(std::max({v0.y, v1.y, v2.y})), float(tileY0 + tileSize - 1));
+    if(bounds.minX > bounds.maxX || bounds.minY > bounds.maxY)
+      continue;
+
+    rasterTriangleScalar(corners, bounds, expected.data(), tileSize, tileX0, tileY0);
+    kernel(corners, bounds, actual.data(), tileSize, tileX0, tileY0);
+  }
+
+  return std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)) == 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <glm/glm.hpp>
+
+// Inner loop of the CPU rasterizer: one triangle into one tile buffer
+// (edge functions, interpolated height, max depth test)
+//
+// All kernels produce bit-exact results: they evaluate the same float expressions in the same order,
+// only the number of columns evaluated at once differs
+enum class RasterKernelType
+{
+  Scalar,
+  Avx2,    // 8 columns
+  Avx512,  // 16 columns
+};
+
+// Columns covered by the triangle inside the tile, in raster space (integral values)
+struct RasterBounds
+{
+  float minX, maxX;
+  float minY, maxY;
+};
+
+// corners: 3 vertices in raster space, triangle must not be degenerate
+// tileBuffer: tile rows of tileStride floats, (tileX0, tileY0) is the raster position of the first column
+using RasterTriangleFn = void (*)(const glm::vec3* corners,
+                                  const RasterBounds& bounds,
+                                  float*              tileBuffer,
+                                  uint32_t            tileStride,
+                                  uint32_t            tileX0,
+                                  uint32_t            tileY0);
+
+void rasterTriangleScalar(const glm::vec3* corners, const RasterBounds& bounds, float* tileBuffer, uint32_t tileStride, uint32_t tileX0, uint32_t tileY0);
+void rasterTriangleAvx2(const glm::vec3* corners, const RasterBounds& bounds, float* tileBuffer, uint32_t tileStride, uint32_t tileX0, uint32_t tileY0);
+void rasterTriangleAvx512(const glm::vec3* corners, const RasterBounds& bounds, float* tileBuffer, uint32_t tileStride, uint32_t tileX0, uint32_t tileY0);
+
+// Best kernel supported by the CPU (and OS)
+RasterKernelType detectRasterKernel();
+bool             isRasterKernelSupported(RasterKernelType type);
+
+RasterTriangleFn getRasterKernel(RasterKernelType type);
+const char*      rasterKernelToString(RasterKernelType type);
+
+// "auto", "scalar", "avx2", "avx512"
+// "auto" selects the best supported kernel, throws for unknown or unsupported kernels
+RasterKernelType selectRasterKernel(const std::string& name);
+
+// Rasterizes a fixed set of random triangles with the kernel and the scalar path
+// Returns true when the tile buffers are bit-exact
+bool verifyRasterKernel(RasterKernelType type);
@@ -0,0 +1,74 @@
+#include "RasterKernel.hpp"
+#include "CpuFeatures.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+
+// FMA is intentionally not used, contracted mul + sub would break bit-exactness with the scalar path
+CPU_TARGET_AVX2 CPU_NO_FP_CONTRACT void rasterTriangleAvx2(const glm::vec3* corners, const RasterBounds& bounds, float* tileBuffer, uint32_t tileStride, uint32_t tileX0, uint32_t tileY0)
+{
+  const glm::vec3& v0 = corners[0];
+  const glm::vec3& v1 = corners[1];
+  const glm::vec3& v2 = corners[2];
+
+  // Same setup as rasterTriangleScalar
+  const float area    = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+  const float sign    = area > 0.0f ? 1.0f : -1.0f;
+  const float invArea = 1.0f / area;
+
+  // w = edgeY * (y - vy) - edgeX * (x - vx)
+  const __m256 edgeX0 = _mm256_set1_ps(v2.y - v1.y);
+  const __m256 edgeX1 = _mm256_set1_ps(v0.y - v2.y);
+  const __m256 edgeX2 = _mm256_set1_ps(v1.y - v0.y);
+  const __m256 vx0    = _mm256_set1_ps(v1.x);
+  const __m256 vx1    = _mm256_set1_ps(v2.x);
+  const __m256 vx2    = _mm256_set1_ps(v0.x);
+  const __m256 z0     = _mm256_set1_ps(v0.z);
+  const __m256 z1     = _mm256_set1_ps(v1.z);
+  const __m256 z2     = _mm256_set1_ps(v2.z);
+  const __m256 signV  = _mm256_set1_ps(sign);
+  const __m256 invA   = _mm256_set1_ps(invArea);
+  const __m256 zero   = _mm256_setzero_ps();
+  const __m256 maxX   = _mm256_set1_ps(bounds.maxX);
+  const __m256 lanes  = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+  for(float y = bounds.minY; y <= bounds.maxY; y += 1.0f)
+  {
+    float* row = tileBuffer + (uint32_t(y) - tileY0) * tileStride;
+
+    // Row constant part of the edge functions
+    const __m256 rowW0 = _mm256_set1_ps((v2.x - v1.x) * (y - v1.y));
+    const __m256 rowW1 = _mm256_set1_ps((v0.x - v2.x) * (y - v2.y));
+    const __m256 rowW2 = _mm256_set1_ps((v1.x - v0.x) * (y - v0.y));
+
+    for(float x = bounds.minX; x <= bounds.maxX; x += 8.0f)
+    {
+      const __m256 xs = _mm256_add_ps(_mm256_set1_ps(x), lanes);
+
+      __m256 w0 = _mm256_sub_ps(rowW0, _mm256_mul_ps(edgeX0, _mm256_sub_ps(xs, vx0)));
+      __m256 w1 = _mm256_sub_ps(rowW1, _mm256_mul_ps(edgeX1, _mm256_sub_ps(xs, vx1)));
+      __m256 w2 = _mm256_sub_ps(rowW2, _mm256_mul_ps(edgeX2, _mm256_sub_ps(xs, vx2)));
+
+      // Columns past maxX must not be loaded or stored (tile row end)
+      const __m256 columnMask = _mm256_cmp_ps(xs, maxX, _CMP_LE_OQ);
+
+      // !(w * sign < 0), NaN counts as inside like in the scalar path
+      __m256 inside = _mm256_cmp_ps(_mm256_mul_ps(w0, signV), zero, _CMP_NLT_UQ);
+      inside        = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_mul_ps(w1, signV), zero, _CMP_NLT_UQ));
+      inside        = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_mul_ps(w2, signV), zero, _CMP_NLT_UQ));
+      inside        = _mm256_and_ps(inside, columnMask);
+      if(_mm256_movemask_ps(inside) == 0)
+        continue;
+
+      __m256 height = _mm256_add_ps(_mm256_mul_ps(w0, z0), _mm256_mul_ps(w1, z1));
+      height        = _mm256_mul_ps(_mm256_add_ps(height, _mm256_mul_ps(w2, z2)), invA);
+
+      // max(height, old) returns old for equal values and NaN, same as std::max(old, height)
+      float*        dst     = row + (uint32_t(x) - tileX0);
+      const __m256i loadMask = _mm256_castps_si256(columnMask);
+      const __m256  old      = _mm256_maskload_ps(dst, loadMask);
+      _mm256_maskstore_ps(dst, _mm256_castps_si256(inside), _mm256_max_ps(height, old));
+    }
+  }
+}
+#endif
@@ -0,0 +1,73 @@
+#include "RasterKernel.hpp"
+#include "CpuFeatures.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+
+// FMA is intentionally not used, contracted mul + sub would break bit-exactness with the scalar path
+CPU_TARGET_AVX512 CPU_NO_FP_CONTRACT void rasterTriangleAvx512(const glm::vec3* corners, const RasterBounds& bounds, float* tileBuffer, uint32_t tileStride, uint32_t tileX0, uint32_t tileY0)
+{
+  const glm::vec3& v0 = corners[0];
+  const glm::vec3& v1 = corners[1];
+  const glm::vec3& v2 = corners[2];
+
+  // Same setup as rasterTriangleScalar
+  const float area    = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+  const float sign    = area > 0.0f ? 1.0f : -1.0f;
+  const float invArea = 1.0f / area;
+
+  // w = edgeY * (y - vy) - edgeX * (x - vx)
+  const __m512 edgeX0 = _mm512_set1_ps(v2.y - v1.y);
+  const __m512 edgeX1 = _mm512_set1_ps(v0.y - v2.y);
+  const __m512 edgeX2 = _mm512_set1_ps(v1.y - v0.y);
+  const __m512 vx0    = _mm512_set1_ps(v1.x);
+  const __m512 vx1    = _mm512_set1_ps(v2.x);
+  const __m512 vx2    = _mm512_set1_ps(v0.x);
+  const __m512 z0     = _mm512_set1_ps(v0.z);
+  const __m512 z1     = _mm512_set1_ps(v1.z);
+  const __m512 z2     = _mm512_set1_ps(v2.z);
+  const __m512 signV  = _mm512_set1_ps(sign);
+  const __m512 invA   = _mm512_set1_ps(invArea);
+  const __m512 zero   = _mm512_setzero_ps();
+  const __m512 maxX   = _mm512_set1_ps(bounds.maxX);
+  const __m512 lanes  = _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f,
+                                       13.0f, 14.0f, 15.0f);
+
+  for(float y = bounds.minY; y <= bounds.maxY; y += 1.0f)
+  {
+    float* row = tileBuffer + (uint32_t(y) - tileY0) * tileStride;
+
+    // Row constant part of the edge functions
+    const __m512 rowW0 = _mm512_set1_ps((v2.x - v1.x) * (y - v1.y));
+    const __m512 rowW1 = _mm512_set1_ps((v0.x - v2.x) * (y - v2.y));
+    const __m512 rowW2 = _mm512_set1_ps((v1.x - v0.x) * (y - v0.y));
+
+    for(float x = bounds.minX; x <= bounds.maxX; x += 16.0f)
+    {
+      const __m512 xs = _mm512_add_ps(_mm512_set1_ps(x), lanes);
+
+      __m512 w0 = _mm512_sub_ps(rowW0, _mm512_mul_ps(edgeX0, _mm512_sub_ps(xs, vx0)));
+      __m512 w1 = _mm512_sub_ps(rowW1, _mm512_mul_ps(edgeX1, _mm512_sub_ps(xs, vx1)));
+      __m512 w2 = _mm512_sub_ps(rowW2, _mm512_mul_ps(edgeX2, _mm512_sub_ps(xs, vx2)));
+
+      // Columns past maxX must not be loaded or stored (tile row end)
+      const __mmask16 columnMask = _mm512_cmp_ps_mask(xs, maxX, _CMP_LE_OQ);
+
+      // !(w * sign < 0), NaN counts as inside like in the scalar path
+      __mmask16 inside = _mm512_mask_cmp_ps_mask(columnMask, _mm512_mul_ps(w0, signV), zero, _CMP_NLT_UQ);
+      inside           = _mm512_mask_cmp_ps_mask(inside, _mm512_mul_ps(w1, signV), zero, _CMP_NLT_UQ);
+      inside           = _mm512_mask_cmp_ps_mask(inside, _mm512_mul_ps(w2, signV), zero, _CMP_NLT_UQ);
+      if(inside == 0)
+        continue;
+
+      __m512 height = _mm512_add_ps(_mm512_mul_ps(w0, z0), _mm512_mul_ps(w1, z1));
+      height        = _mm512_mul_ps(_mm512_add_ps(height, _mm512_mul_ps(w2, z2)), invA);
+
+      // max(height, old) returns old for equal values and NaN, same as std::max(old, height)
+      float*       dst = row + (uint32_t(x) - tileX0);
+      const __m512 old = _mm512_maskz_loadu_ps(columnMask, dst);
+      _mm512_mask_storeu_ps(dst, inside, _mm512_max_ps(height, old));
+    }
+  }
+}
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// One orientation to evaluate
+// Same orthographic setup as updateSceneBuffer:
+// - view space is the mesh rotated by viewMatrix (rotation only)
+// - column (x, y) samples view position (aabbMin.x + x * stepX, aabbMax.y - y * stepY)
+//   where step = aabb size / (resolution - 1)
+struct VolumeEvaluationView
+{
+  glm::mat4  viewMatrix{1.0f};
+  glm::vec3  aabbMin{};
+  glm::vec3  aabbMax{};
+  glm::uvec2 resolution{};
+
+  glm::vec2 getCellSize() const
+  {
+    return {(aabbMax.x - aabbMin.x) / float(resolution.x - 1), (aabbMax.y - aabbMin.y) / float(resolution.y - 1)};
+  }
+};
+
+// Backend that calculates support volume without the Vulkan pipeline
+class VolumeEvaluator
+{
+public:
+  virtual ~VolumeEvaluator() = default;
+
+  // Calculate support volume for one orientation
+  virtual float evaluate(const VolumeEvaluationView& view) = 0;
+
+  // Print accumulated statistics (timings etc.)
+  virtual void printStats() const {}
+};
@@ -0,0 +1,120 @@
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned int threadCount)
+{
+  if(threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  queues.reserve(threadCount);
+  for(unsigned int i = 0; i < threadCount; ++i)
+    queues.push_back(std::make_unique<TaskQueue>());
+
+  threads.reserve(threadCount);
+  for(unsigned int i = 0; i < threadCount; ++i)
+    threads.emplace_back([this, i]() { workerLoop(i); });
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard lock(mtx);
+    stopping = true;
+  }
+  workCv.notify_all();
+  threads.clear();  // joins
+}
+
+void WorkerPool::parallelFor(uint32_t count, const std::function<void(uint32_t, unsigned int)>& task)
+{
+  if(count == 0)
+    return;
+
+  const unsigned int workerCount = getThreadCount();
+
+  std::unique_lock lock(mtx);
+
+  // Contiguous blocks keep neighbouring tasks (tiles, rows) on the same worker
+  for(unsigned int w = 0; w < workerCount; ++w)
+  {
+    uint32_t blockStart = uint32_t(uint64_t(count) * w / workerCount);
+    uint32_t blockEnd   = uint32_t(uint64_t(count) * (w + 1) / workerCount);
+
+    std::lock_guard queueLock(queues[w]->mtx);
+    for(uint32_t i = blockStart; i < blockEnd; ++i)
+      queues[w]->indices.push_back(i);
+  }
+
+  currentTask = &task;
+  remaining   = count;
+  ++generation;
+  workCv.notify_all();
+
+  // Wait for all tasks and for all workers to stop referencing the task
+  doneCv.wait(lock, [this]() { return remaining == 0 && activeWorkers == 0; });
+  currentTask = nullptr;
+}
+
+bool WorkerPool::popTask(unsigned int workerIndex, uint32_t& index)
+{
+  // Own queue first (front, in order)
+  {
+    TaskQueue&      own = *queues[workerIndex];
+    std::lock_guard lock(own.mtx);
+    if(!own.indices.empty())
+    {
+      index = own.indices.front();
+      own.indices.pop_front();
+      return true;
+    }
+  }
+
+  // Steal from the back of other queues
+  const unsigned int workerCount = getThreadCount();
+  for(unsigned int offset = 1; offset < workerCount; ++offset)
+  {
+    TaskQueue&      victim = *queues[(workerIndex + offset) % workerCount];
+    std::lock_guard lock(victim.mtx);
+    if(!victim.indices.empty())
+    {
+      index = victim.indices.back();
+      victim.indices.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkerPool::workerLoop(unsigned int workerIndex)
+{
+  uint64_t lastGeneration = 0;
+
+  while(true)
+  {
+    const std::function<void(uint32_t, unsigned int)>* task = nullptr;
+    {
+      std::unique_lock lock(mtx);
+      workCv.wait(lock, [&]() { return stopping || (generation != lastGeneration && remaining > 0); });
+      if(stopping)
+        return;
+
+      lastGeneration = generation;
+      task           = currentTask;
+      ++activeWorkers;
+    }
+
+    uint32_t index;
+    while(popTask(workerIndex, index))
+    {
+      (*task)(index, workerIndex);
+      --remaining;
+    }
+
+    {
+      std::lock_guard lock(mtx);
+      --activeWorkers;
+    }
+    doneCv.notify_one();
+  }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker threads used by the CPU evaluators
+// Every worker owns a queue of task indices, idle workers steal from the others
+class WorkerPool
+{
+public:
+  // threadCount = 0 uses all hardware threads
+  explicit WorkerPool(unsigned int threadCount = 0);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&)            = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  unsigned int getThreadCount() const { return (unsigned int)threads.size(); }
+
+  // Runs task(index, workerIndex) for every index in [0, count)
+  // Blocks until all tasks are done
+  // Indices are split into contiguous blocks, one block per worker queue
+  void parallelFor(uint32_t count, const std::function<void(uint32_t index, unsigned int workerIndex)>& task);
+
+private:
+  struct TaskQueue
+  {
+    std::mutex           mtx;
+    std::deque<uint32_t> indices;
+  };
+
+  std::vector<std::unique_ptr<TaskQueue>> queues;
+  std::vector<std::jthread>               threads;
+
+  // Synchronization between parallelFor and workers
+  std::mutex              mtx;
+  std::condition_variable workCv;
+  std::condition_variable doneCv;
+  uint64_t                generation    = 0;
+  unsigned int            activeWorkers = 0;
+  bool                    stopping      = false;
+  std::atomic<uint32_t>   remaining     = 0;
+
+  const std::function<void(uint32_t, unsigned int)>* currentTask = nullptr;
+
+  void workerLoop(unsigned int workerIndex);
+  bool popTask(unsigned int workerIndex, uint32_t& index);
+};
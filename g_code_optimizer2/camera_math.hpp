@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glm/gtx/quaternion.hpp>
+
+// Camera orientation math shared by CustomCamera and the algorithms
+// Algorithms use it to know the rotation of a request before the camera is moved (batched requests)
+namespace camera_math {
+
+// Camera looks along rotation * defaultForward
+inline const glm::vec3 defaultForward = {0, 0, -1};
+
+// Rotation looking at the center from a position on the sphere
+inline glm::quat positionToRotation(glm::vec3 position)
+{
+  glm::vec3 forward = -glm::normalize(position);
+  return glm::normalize(glm::rotation(defaultForward, forward));
+}
+
+// Rotation after moving on the sphere in the local right/up axes of the camera
+inline glm::quat moveRotation(glm::quat rotation, glm::vec2 direction)
+{
+  // Skip if no move
+  if(direction.x == 0 && direction.y == 0)
+    return rotation;
+
+  glm::vec3 local_right = rotation * glm::vec3(1.0f, 0.0f, 0.0f);
+  glm::vec3 local_up    = rotation * glm::vec3(0.0f, 1.0f, 0.0f);
+  return glm::normalize(glm::angleAxis(-direction.x, local_up) * glm::angleAxis(-direction.y, local_right) * rotation);
+}
+
+// Rotation with the same forward direction and no roll
+inline glm::quat quatNoRoll(glm::quat rotation)
+{
+  glm::vec3 forward = glm::normalize(rotation * defaultForward);
+  return glm::rotation(defaultForward, forward);
+}
+
+// Roll around the forward direction relative to quatNoRoll
+inline float roll(glm::quat rotation)
+{
+  glm::quat diff  = rotation * glm::conjugate(quatNoRoll(rotation));
+  float     angle = glm::angle(diff);
+
+  // Axis of diff is the forward direction or its opposite
+  return glm::dot(glm::axis(diff), rotation * defaultForward) < 0 ? -angle : angle;
+}
+
+}  // namespace camera_math
@@ -1,4 +1,5 @@
 #include "custom_camera.hpp"
+#include "camera_math.hpp"
 #include <iostream>
 
 #include <nvgui/window.hpp>
@@ -47,13 +48,7 @@ void CustomCamera::onUIRender()
 
 void CustomCamera::move(glm::vec2 direction)
 {
-  // Skip if no move
-  if(direction.x == 0 && direction.y == 0)
-    return;
-
-  glm::vec3 local_right = rotation * glm::vec3(1.0f, 0.0f, 0.0f);
-  glm::vec3 local_up    = rotation * glm::vec3(0.0f, 1.0f, 0.0f);
-  rotation = glm::normalize(glm::angleAxis(-direction.x, local_up) * glm::angleAxis(-direction.y, local_right) * rotation);
+  rotation = camera_math::moveRotation(rotation, direction);
 }
 
 void CustomCamera::roll(float amount)
@@ -64,7 +59,7 @@ void CustomCamera::roll(float amount)
 
 void CustomCamera::setPositionOnSphere(glm::vec3 position)
 {
-  rotation = glm::normalize(convertPositionToQuat(position));
+  rotation = camera_math::positionToRotation(position);
 }
 
 glm::quat CustomCamera::convertPositionToQuat(glm::vec3 position)
@@ -82,8 +77,7 @@ glm::vec3 CustomCamera::getPosition()
 
 glm::quat CustomCamera::getQuatNoRoll(glm::quat quat)
 {
-  glm::vec3 forward = glm::normalize(quat * defaultForward);
-  return glm::rotation(defaultForward, forward);
+  return camera_math::quatNoRoll(quat);
 }
 
 glm::mat4x4 CustomCamera::getViewMatrix()
@@ -99,18 +93,7 @@ glm::mat4x4 CustomCamera::getViewMatrixNoRoll()
 
 float CustomCamera::getRoll()
 {
-  glm::quat quatNoRoll = getQuatNoRoll(rotation);
-  glm::quat diff       = rotation * glm::conjugate(quatNoRoll);
-  float     angle      = glm::angle(diff);
-
-  if(dot(glm::axis(diff), -defaultForward) > 0)
-  {
-    return -angle;
-  }
-  else
-  {
-    return angle;
-  }
+  return camera_math::roll(rotation);
 }
 
 }  // namespace nvapp
@@ -75,32 +75,69 @@
 #include "volumesum_compute.hpp"
 #include "_autogen/volumesum_compute.slang.h"
 
+// Fused volume integration and reduction
+#include "volume_fused_compute.hpp"
+#include "_autogen/volume_fused.slang.h"
+
 // Camera
 #include "custom_camera.hpp"
 
 // Algorithms
 #include "Algorithms/AlgorithmSync.hpp"
 
+// CPU volume evaluation
+#include "Evaluators/CpuRasterEvaluator.hpp"
+#include "Evaluators/CpuRayEvaluator.hpp"
+#include "Evaluators/CpuAabb.hpp"
+#include "Evaluators/AnalyticEvaluator.hpp"
+#include "Evaluators/HullBound.hpp"
+#include "Evaluators/NormalBins.hpp"
+#include "Evaluators/FacetSeeds.hpp"
+#include "Evaluators/OverhangProxy.hpp"
+#include "Evaluators/MeshSimplifier.hpp"
+
 #include <glm/gtx/quaternion.hpp>
 
+#include <deque>
+#include <format>
+
 // Python
 #include "python_volume_forwarder.hpp"
 
 // Json, app config
 #include "include/json_helpers.hpp"
 #include "include/app_config.hpp"
+#include "include/hash_helpers.hpp"
 
 static const std::map<std::string, AlgorithmType> stringToAlgoType{{"test", AlgorithmType::Test},
                                                                    {"basic", AlgorithmType::UniformPoints},
                                                                    {"deterministic", AlgorithmType::Deterministic},
                                                                    {"stochastic", AlgorithmType::Stochastic},
+                                                                   {"cmaes", AlgorithmType::Cmaes},
+                                                                   {"surrogate", AlgorithmType::Surrogate},
+                                                                   {"evolution", AlgorithmType::Evolution},
+                                                                   {"direct", AlgorithmType::Direct},
+                                                                   {"multifidelity", AlgorithmType::MultiFidelity},
                                                                    {"python", AlgorithmType::Python}};
 static const std::map<AlgorithmType, std::string> algoTypeToString{{AlgorithmType::Test, "test"},
                                                                    {AlgorithmType::UniformPoints, "basic"},
                                                                    {AlgorithmType::Deterministic, "deterministic"},
                                                                    {AlgorithmType::Stochastic, "stochastic"},
+                                                                   {AlgorithmType::Cmaes, "cmaes"},
+                                                                   {AlgorithmType::Surrogate, "surrogate"},
+                                                                   {AlgorithmType::Evolution, "evolution"},
+                                                                   {AlgorithmType::Direct, "direct"},
+                                                                   {AlgorithmType::MultiFidelity, "multifidelity"},
                                                                    {AlgorithmType::Python, "python"}};
 
+enum class EvaluationBackend
+{
+  Gpu,
+  Cpu
+};
+static const std::map<std::string, EvaluationBackend> stringToBackend{{"gpu", EvaluationBackend::Gpu},
+                                                                      {"cpu", EvaluationBackend::Cpu}};
+
 //---------------------------------------------------------------------------------------
 class GCodeOptimizer2 : public nvapp::IAppElement
 {
@@ -111,11 +148,27 @@ class GCodeOptimizer2 : public nvapp::IAppElement
     eImgVolume
   };
 
+  // Evaluation of a rotation, GPU evaluations wait in gpuEvaluations until their readback (same order as the ring)
+  struct Evaluation
+  {
+    uint64_t           requestId  = 0;   // tag of the readback
+    int                batchIndex = -1;  // index in the batch, -1 outside of batches
+    glm::quat          rotation{};
+    shaderio::float4x4 viewInvMatrix{};
+    glm::vec3          position{};
+    int                lod             = 0;
+    int                resolutionLevel = 0;
+    bool               analytic        = false;
+    bool               forAlgorithm    = false;  // false for the viewport
+  };
+
 public:
   struct Inputs
   {
     std::string algorithm   = "";
     bool        raytraced   = false;
+    std::string backend     = "gpu";
+    std::string cpuKernel   = "auto";
     bool        headless    = false;
     bool        closeOnDone = false;
 
@@ -131,6 +184,37 @@ public:
     unsigned int maxEvals    = 0;
     std::string  outputStats = "";
 
+    // Evaluation cache, rotations closer than the tolerance (radians) are evaluated once. 0 disables the cache
+    float cacheTolerance = 1e-6f;
+    // Directory of the persistent cache (one file per mesh and evaluation settings). Empty keeps the cache in memory
+    std::string cacheDir = "";
+
+    // Evaluate every requested rotation without roll, the search space is the sphere of build directions
+    bool rollInvariant = false;
+
+    // Branch and bound: the convex hull bound is lowered by this fraction to allow for the sampling error of the
+    // raster/ray volume. Not a proven bound, pruning can change the result (BranchAndBound is off in the configs)
+    float boundMargin = 0.05f;
+
+    // Facets leaning further than this from the vertical (degrees) count as overhang in the proxy pre-filter
+    float overhangAngle = 45.0f;
+
+    // Levels of detail built at load time, algorithms can evaluate coarse levels (e.g. the global sweep)
+    int   lodLevels   = 0;       // 0 disables, at most MAX_LOD_LEVELS
+    float lodRatio    = 0.25f;   // triangles of a level relative to the previous one
+    float lodMaxError = 0.002f;  // RMS distance of a level from the mesh, relative to the diagonal of the mesh bounds
+
+    // AABB of every rotation by the GPU compute pass (one blocking submit per evaluation), CPU otherwise
+    bool gpuAabb = false;
+
+    // GPU results in flight (staging buffers of the readback ring), batches keep up to this many rotations in flight
+    unsigned int readbackSlots = 4;
+
+    // Integrate and reduce the height field in one subgroup pass (separate passes without subgroup arithmetic)
+    bool fusedVolume = false;
+    // Times both volume pipelines with this many evaluations when the algorithm starts. 0 disables
+    unsigned int volumeBenchmark = 0;
+
     // Used by Cura Voxelizer
     std::string outputQuat = "";
     std::string vertsFile  = "";
@@ -146,6 +230,8 @@ public:
     int         algo_iterations = 0;
     float       result          = 0;
     glm::vec3   position{};
+    float       cache_hit_rate  = 0;   // evaluation cache hits / lookups
+    float       optimality_gap  = -1;  // remaining gap to the global minimum (relative), -1 without a proven bound
   } algoStats;
 
   GCodeOptimizer2(Inputs inputs)
@@ -157,25 +243,7 @@ public:
   // - Called when the application initialize
   void onAttach(nvapp::Application* app) override
   {
-    if(inputs.textureResolution != 0)
-    {
-      // Set fixed texture resolution size
-      VkExtent2D resolution = {inputs.textureResolution, inputs.textureResolution};
-      setCurrentResolution(resolution);
-      if(inputs.headless)
-      {
-        // limit resolution in headless
-        setMaxResolution(resolution);
-        m_maxRenderResolution = resolution;
-      }
-    }
-
-    if(inputs.voxelSpacing != 0)
-    {
-      // Use dynamic texture resolution while respecting voxel spacing
-      useFixedAreaResolution = true;
-      areaResolution         = inputs.voxelSpacing;
-    }
+    setupResolution();
 
     m_app = app;
 
@@ -218,17 +286,26 @@ public:
     };
     m_gBuffers.init(gBufferInit);
 
+    // Fused volume pass, the full resolution buffer of the separate passes is only needed by the benchmark
+    m_fusedVolumeSupported = nvshaders::VolumeFusedCompute::isSupported(m_app->getPhysicalDevice());
+    m_useFusedVolume       = inputs.fusedVolume && m_fusedVolumeSupported;
+    if(inputs.fusedVolume && !m_useFusedVolume)
+      std::cout << "[Volume] subgroup arithmetic not supported, using separate integration and reduction passes\n";
+
     auto cmd = m_app->createTempCmdBuffer();
     resizeBuffers(cmd, m_maxRenderResolution);
     m_app->submitAndWaitTempCmdBuffer(cmd);
 
-    if(inputs.raytraced && !hasRtx)
+    selectBackend();
+
+    if(inputs.raytraced && !hasRtx && m_backend == EvaluationBackend::Gpu)
     {
       std::string error = "Error: ray tracing not supported on this GPU\n";
       throw std::runtime_error(error);
     }
 
-    m_useRayTracing = inputs.raytraced;
+    // cpu backend ray casts on the CPU, GPU is only used for the viewport (raster)
+    m_useRayTracing = inputs.raytraced && m_backend == EvaluationBackend::Gpu;
 
     createScene();                        // Create the scene with a teapot and a plane
     createGraphicsDescriptorSetLayout();  // Create the descriptor set layout for the graphics pipeline
@@ -260,7 +337,56 @@ public:
 
     m_aabbCompute.cleanupAfterInit(&m_allocator);
     m_volumeIntegrateCompute.init(&m_allocator, volume_integrate_slang);
-    m_volumeSumCompute.init(&m_allocator, volumesum_compute_slang);
+    if(m_fusedVolumeSupported)
+      m_volumeFusedCompute.init(&m_allocator, volume_fused_slang);
+    m_volumeSumCompute.init(&m_allocator, volumesum_compute_slang, m_app->getQueue(0).queue, std::max(inputs.readbackSlots, 1u));
+
+    initEvaluation();
+  }
+
+  // Texture resolution of the evaluations from the inputs
+  void setupResolution()
+  {
+    if(inputs.textureResolution != 0)
+    {
+      // Set fixed texture resolution size
+      VkExtent2D resolution = {inputs.textureResolution, inputs.textureResolution};
+      setCurrentResolution(resolution);
+      if(inputs.headless)
+      {
+        // limit resolution in headless
+        setMaxResolution(resolution);
+        m_maxRenderResolution = resolution;
+      }
+    }
+
+    if(inputs.voxelSpacing != 0)
+    {
+      // Use dynamic texture resolution while respecting voxel spacing
+      useFixedAreaResolution = true;
+      areaResolution         = inputs.voxelSpacing;
+    }
+  }
+
+  // Select volume evaluation backend
+  void selectBackend()
+  {
+    auto it = stringToBackend.find(inputs.backend);
+    if(it == stringToBackend.end())
+    {
+      throw std::runtime_error("unknown backend (" + inputs.backend + ")");
+    }
+    m_backend = it->second;
+  }
+
+  // Evaluators, limits and the algorithm to start, after the mesh is loaded
+  void initEvaluation()
+  {
+    if(m_backend == EvaluationBackend::Cpu)
+    {
+      m_cpuEvaluator = createCpuEvaluator(triangles);
+      m_cpuLodEvaluators.resize(meshLods.size());
+    }
 
     // Calculate limits
     {
@@ -307,6 +433,44 @@ public:
     programInitTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - programStartTime);
   }
 
+  //-------------------------------------------------------------------------------
+  // Headless run of the cpu backend without Vulkan (no application, frame loop or GPU resources)
+  // The algorithm is driven in a tight loop, one evaluation per iteration (or one batch)
+  void runComputeOnly()
+  {
+    setupResolution();
+    selectBackend();
+    if(m_backend != EvaluationBackend::Cpu)
+      throw std::runtime_error("compute only mode requires the cpu backend");
+
+    LoadMesh();
+    initEvaluation();
+
+    // StopAlgorithm returns false once all runs are done (headless always closes on done)
+    while(RunAlgorithm())
+    {
+      if(!hasEvaluationToIssue())
+        continue;
+
+      updateViewMatrixFromCamera();
+      currentLod             = getRequestedLod();
+      currentResolutionLevel = getRequestedResolutionLevel();
+
+      // Batch up to the last rotation
+      EvaluateBatchOnCpu();
+
+      RecalculateAABB();
+      updateResolution();
+
+      if(EvaluateVolumeAnalytic())
+        OnVolumeResult(issueEvaluation(), analyticVolume);
+      else
+        EvaluateVolumeCpu();
+    }
+
+    SaveResult();
+  }
+
   //-------------------------------------------------------------------------------
   // Destroy all elements that were created
   // - Called when the application is shutting down
@@ -343,6 +507,7 @@ public:
     m_stagingUploader.deinit();
     m_aabbCompute.deinit();
     m_volumeIntegrateCompute.deinit();
+    m_volumeFusedCompute.deinit();
     m_volumeSumCompute.deinit();
     m_samplerPool.deinit();
 
@@ -372,7 +537,7 @@ public:
     if(ImGui::Begin("Settings"))
     {
       // Ray tracing toggle
-      ImGui::BeginDisabled(!hasRtx || isAlgoRunning);
+      ImGui::BeginDisabled(!hasRtx || isAlgoRunning || m_backend == EvaluationBackend::Cpu);
       ImGui::Checkbox("Use Ray Tracing", &m_useRayTracing);
       ImGui::EndDisabled();
 
@@ -493,10 +658,14 @@ public:
     VkDeviceSize bufferSize             = elemCount * sizeof(float);
     VkDeviceSize bufferSizeForReduction = m_volumeSumCompute.calculateMaxGroups((int)elemCount) * sizeof(float);
 
-    m_allocator.createBuffer(m_outVolumeBuffer, bufferSize,
-                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                             VMA_MEMORY_USAGE_AUTO);
-    NVVK_DBG_NAME(m_outVolumeBuffer.buffer);
+    // Only the separate passes write every integrated cell
+    if(!m_useFusedVolume || inputs.volumeBenchmark > 0)
+    {
+      m_allocator.createBuffer(m_outVolumeBuffer, bufferSize,
+                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VMA_MEMORY_USAGE_AUTO);
+      NVVK_DBG_NAME(m_outVolumeBuffer.buffer);
+    }
 
     if(m_outVolumeBufferForReduction.buffer != VK_NULL_HANDLE)
     {
@@ -518,7 +687,7 @@ public:
   {
     NVVK_DBG_SCOPE(cmd);  // <-- Helps to debug in NSight
 
-    // Calculate volume
+    // Read volumes of earlier frames
     GetVolumeCalculationResult();
 
     // Forward to python
@@ -529,9 +698,20 @@ public:
     if(!RunAlgorithm())
       return;  // Algorithm done, exit
 
+    // Everything of the current request is in flight
+    if(!hasEvaluationToIssue())
+      return;
+
     // Update view matrix
     updateViewMatrixFromCamera();
 
+    // Level of detail and grid resolution of this frame
+    currentLod             = getRequestedLod();
+    currentResolutionLevel = getRequestedResolutionLevel();
+
+    // Evaluate the batch up to the last rotation when it doesn't need the GPU
+    EvaluateBatchOnCpu();
+
     // Recalculate AABB
     RecalculateAABB();
 
@@ -541,6 +721,25 @@ public:
     // Update the scene information buffer, this cannot be done in between dynamic rendering
     updateSceneBuffer(cmd);
 
+    // Analytic estimate requested by the algorithm, the selected backend is used when it is ambiguous
+    if(EvaluateVolumeAnalytic())
+    {
+      OnVolumeResult(issueEvaluation(), analyticVolume);
+      if(!inputs.headless)
+        rasterScene(cmd);
+      return;
+    }
+
+    if(m_backend == EvaluationBackend::Cpu)
+    {
+      EvaluateVolumeCpu();
+
+      // GPU raster is only used for the viewport
+      if(!inputs.headless)
+        rasterScene(cmd);
+      return;
+    }
+
     if(m_useRayTracing)
     {
       raytraceScene(cmd);
@@ -550,9 +749,9 @@ public:
       rasterScene(cmd);
     }
 
-    IntegrateVolume(cmd);
+    CalculateVolume(cmd, m_useFusedVolume);
 
-    CalculateVolume(cmd);
+    RecordVolumeReadback(cmd);
 
     //postProcess(cmd);
   }
@@ -614,9 +813,11 @@ public:
         {.baseColorFactor = glm::vec4(0.8f, 1.0f, 0.6f, 1.0f), .metallicFactor = 0.5f, .roughnessFactor = 0.5f}};
 
 
-    m_sceneResource.instances = {
-        // Teapot
-        {.transform = glm::translate(glm::mat4(1), glm::vec3(0, 0, 0)), .materialIndex = 0, .meshIndex = 0}};
+    // One instance per level of detail (instance i uses mesh i), only the evaluated level is drawn and traced
+    m_sceneResource.instances.clear();
+    for(uint32_t level = 0; level < m_sceneResource.meshes.size(); ++level)
+      m_sceneResource.instances.push_back(
+          {.transform = glm::translate(glm::mat4(1), glm::vec3(0, 0, 0)), .materialIndex = 0, .meshIndex = level});
 
 
     nvsamples::createGltfSceneInfoBuffer(m_sceneResource, m_stagingUploader);  // Create buffers for the scene data (GPU buffers)
@@ -890,6 +1091,10 @@ public:
 
     for(size_t i = 0; i < m_sceneResource.instances.size(); i++)
     {
+      // Other levels of detail
+      if(i != (size_t)currentLod)
+        continue;
+
       uint32_t                      meshIndex = m_sceneResource.instances[i].meshIndex;
       const shaderio::GltfMesh&     gltfMesh  = m_sceneResource.meshes[meshIndex];
       const shaderio::TriangleMesh& triMesh   = gltfMesh.triMesh;
@@ -999,7 +1204,7 @@ public:
       ray_inst.accelerationStructureReference         = m_asBuilder.blasSet[instance.meshIndex].address;
       ray_inst.instanceShaderBindingTableRecordOffset = 0;  // We will use the same hit group for all objects
       ray_inst.flags                                  = flags;
-      ray_inst.mask                                   = 0xFF;
+      ray_inst.mask                                   = uint8_t(1u << instance.meshIndex);  // level of detail
       tlasInstances.emplace_back(ray_inst);
     }
 
@@ -1173,7 +1378,8 @@ public:
     shaderio::RtxPushConstant pushValues{.sceneInfoAddress = (shaderio::GltfSceneInfo*)m_sceneResource.bSceneInfo.address,
                                          .aabbMin          = aabbMin,
                                          .aabbMax          = aabbMax,
-                                         .maxSupportHeight = maxSupportHeight};
+                                         .maxSupportHeight = maxSupportHeight,
+                                         .instanceMask     = 1u << currentLod};
     const VkPushConstantsInfo pushInfo{.sType      = VK_STRUCTURE_TYPE_PUSH_CONSTANTS_INFO,
                                        .layout     = m_rtPipelineLayout,
                                        .stageFlags = VK_SHADER_STAGE_ALL,
@@ -1194,9 +1400,19 @@ public:
                                       {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}});
   }
 
-  // Recalculate AABB (GPU implementation)
+  // Recalculate AABB (CPU over the convex hull vertices, GPU implementation with gpuAabb)
   void RecalculateAABB()
   {
+    if(!inputs.gpuAabb || m_backend == EvaluationBackend::Cpu)
+    {
+      auto result = m_cpuAabb->compute(viewMatrix);
+      aabbMin     = result.min;
+      aabbMax     = result.max;
+
+      aabbMax.z += glm::max(aabbMax.z * 0.00001f, 0.001f);  // Add small epsilon
+      return;
+    }
+
     VkCommandBuffer cmd = m_app->createTempCmdBuffer();
 
     auto sceneInfo = m_sceneResource.bSceneInfo;
@@ -1212,69 +1428,413 @@ public:
     aabbMax.z += glm::max(aabbMax.z * 0.00001f, 0.001f);  // Add small epsilon
   }
 
-  void IntegrateVolume(VkCommandBuffer cmd)
+  // Size of one integrated area
+  shaderio::float2 getIntegratedAreaSize() const
   {
     float width  = (aabbMax.x - aabbMin.x);
     float height = (aabbMax.y - aabbMin.y);
 
+    return {(width) / (float)(m_currentRenderResolution.width - 1), (height) / (float)(m_currentRenderResolution.height - 1)};
+  }
+
+  void IntegrateVolume(VkCommandBuffer cmd)
+  {
     // (n) * (m) => (n-1) * (m-1)
     m_volumeIntegrateCompute.runCompute(cmd, m_gBuffers.getColorImageView(eImgVolume), &m_outVolumeBuffer,
                                         {(m_currentRenderResolution.width), m_currentRenderResolution.height},
-                                        {// size of one integrated area
-                                         (width) / (float)(m_currentRenderResolution.width - 1),
-                                         (height) / (float)(m_currentRenderResolution.height - 1)});
+                                        getIntegratedAreaSize());
   }
 
-  void CalculateVolume(VkCommandBuffer cmd)
+  // Volume of the height field, the result stays in the result buffer of m_volumeSumCompute
+  void CalculateVolume(VkCommandBuffer cmd, bool fused)
   {
+    if(fused)
+    {
+      // (n) * (m) => partial sum per group => 1
+      uint32_t groupCount = m_volumeFusedCompute.runCompute(cmd, m_gBuffers.getColorImageView(eImgVolume),
+                                                            {(m_currentRenderResolution.width), m_currentRenderResolution.height},
+                                                            getIntegratedAreaSize());
+      m_volumeSumCompute.runCompute(cmd, (int)groupCount, m_volumeFusedCompute.getPartialBuffer(), &m_outVolumeBufferForReduction);
+      return;
+    }
+
+    IntegrateVolume(cmd);
+
     // (n-1) * (m-1) => 1
     m_volumeSumCompute.runCompute(cmd, (m_currentRenderResolution.width - 1) * (m_currentRenderResolution.height - 1),
                                   &m_outVolumeBuffer, &m_outVolumeBufferForReduction);
   }
 
+  void RecordVolumeReadback(VkCommandBuffer cmd)
+  {
+    // Result is read a few frames later, tagged with the id of this evaluation
+    Evaluation evaluation = issueEvaluation();
+    evaluation.requestId  = nextRequestId++;
+    gpuEvaluations.push_back(evaluation);
+    m_volumeSumCompute.recordCopyResultToStaging(cmd, evaluation.requestId);
+  }
+
+  // Evaluate volume for the current camera on the CPU
+  void EvaluateVolumeCpu()
+  {
+    OnVolumeResult(issueEvaluation(), getCpuEvaluator(currentLod).evaluate(getVolumeEvaluationView()));
+  }
+
+  // Evaluate volume analytically if the current algorithm request asks for it
+  // Returns false when the full evaluation has to be used (not requested or ambiguous occlusion)
+  bool EvaluateVolumeAnalytic()
+  {
+    analyticVolumeValid = false;
+    if(!m_algo->isAlgorithmRunning())
+      return false;
+
+    auto requestBase = std::visit([](AlgoRequestBase& r) { return r; }, algoRequest);
+    if(requestBase.evaluationMode != EvaluationMode::Analytic)
+      return false;
+
+    // Same metric as the selected pipeline
+    if(!m_analyticEvaluator)
+      m_analyticEvaluator = std::make_unique<AnalyticEvaluator>(triangles, inputs.raytraced ? AnalyticEvaluator::Metric::Support :
+                                                                                              AnalyticEvaluator::Metric::HeightField);
+
+    analyticVolumeValid = m_analyticEvaluator->tryEvaluate(getVolumeEvaluationView(), analyticVolume);
+    return analyticVolumeValid;
+  }
+
+  std::unique_ptr<VolumeEvaluator> createCpuEvaluator(const std::vector<openstl::Triangle>& meshTriangles) const
+  {
+    // scalar kernel also disables packet traversal of the ray caster
+    RasterKernelType kernel = selectRasterKernel(inputs.cpuKernel);
+    if(inputs.raytraced)
+      return std::make_unique<CpuRayEvaluator>(meshTriangles, kernel == RasterKernelType::Scalar ?
+                                                                  CpuRayEvaluator::Traversal::Single :
+                                                                  CpuRayEvaluator::defaultTraversal());
+    return std::make_unique<CpuRasterEvaluator>(meshTriangles, kernel);
+  }
+
+  // CPU evaluator of a level of detail, coarse levels are created on their first request
+  VolumeEvaluator& getCpuEvaluator(int lod)
+  {
+    if(lod == 0)
+      return *m_cpuEvaluator;
+
+    auto& evaluator = m_cpuLodEvaluators[lod - 1];
+    if(!evaluator)
+      evaluator = createCpuEvaluator(meshLods[lod - 1].triangles);
+    return *evaluator;
+  }
+
+  // Level of detail requested by the running algorithm, clamped to the built levels
+  // Analytic estimates always use the full mesh
+  int getRequestedLod()
+  {
+    if(!m_algo->isAlgorithmRunning())
+      return 0;
+
+    auto requestBase = std::visit([](AlgoRequestBase& r) { return r; }, algoRequest);
+    return std::clamp(requestBase.lod, 0, (int)meshLods.size());
+  }
+
+  // Resolution level requested by the running algorithm, the grid is halved per level
+  int getRequestedResolutionLevel()
+  {
+    if(!m_algo->isAlgorithmRunning())
+      return 0;
+
+    auto requestBase = std::visit([](AlgoRequestBase& r) { return r; }, algoRequest);
+    return std::clamp(requestBase.resolutionLevel, 0, MAX_RESOLUTION_LEVEL);
+  }
+
+  // Persistent cache file of the current mesh and evaluation settings, empty without cacheDir
+  std::filesystem::path getEvaluationCacheFile() const
+  {
+    if(inputs.cacheDir.empty())
+      return {};
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for(const auto& t : triangles)
+    {
+      hash = hashBytes(&t.v0, sizeof(t.v0), hash);
+      hash = hashBytes(&t.v1, sizeof(t.v1), hash);
+      hash = hashBytes(&t.v2, sizeof(t.v2), hash);
+    }
+    hash = hashBytes(&inputs.raytraced, sizeof(inputs.raytraced), hash);
+    // Backends sum the height field in a different order, their volumes differ in the low bits
+    hash = hashBytes(&m_backend, sizeof(m_backend), hash);
+    // The fused pass sums in a different order, its volumes differ in the low bits
+    if(m_backend == EvaluationBackend::Gpu && m_useFusedVolume)
+      hash = hashString("fused", hash);
+    if(!meshLods.empty())
+    {
+      // Evaluations of coarse levels depend on the simplification
+      hash = hashString("lod", hash);
+      hash = hashBytes(&inputs.lodLevels, sizeof(inputs.lodLevels), hash);
+      hash = hashBytes(&inputs.lodRatio, sizeof(inputs.lodRatio), hash);
+      hash = hashBytes(&inputs.lodMaxError, sizeof(inputs.lodMaxError), hash);
+    }
+    if(useFixedAreaResolution)
+    {
+      hash = hashString("area", hash);
+      hash = hashBytes(&areaResolution, sizeof(areaResolution), hash);
+    }
+    else
+    {
+      hash = hashString("texture", hash);
+      hash = hashBytes(&currentResolutionWidth, sizeof(currentResolutionWidth), hash);
+      hash = hashBytes(&currentResolutionHeight, sizeof(currentResolutionHeight), hash);
+    }
+
+    return std::filesystem::path(inputs.cacheDir) / std::format("{:016x}.json", hash);
+  }
+
+  // Inputs that change which rotations a run evaluates without changing the volumes, part of the key of cached runs
+  // The proxy is built at load time, so its angle is the one it was built with
+  std::string getRunSettings() const
+  {
+    return std::format("boundMargin={}:overhangAngle={}", inputs.boundMargin, m_overhangProxyAngle);
+  }
+
+  VolumeEvaluationView getVolumeEvaluationView() const
+  {
+    return {.viewMatrix = viewMatrix,
+            .aabbMin    = aabbMin,
+            .aabbMax    = aabbMax,
+            .resolution = {m_currentRenderResolution.width, m_currentRenderResolution.height}};
+  }
+
+  // Reads the GPU results that are ready, waits only when nothing else can be evaluated in this frame
   void GetVolumeCalculationResult()
   {
-    if(m_volumeSumCompute.IsResultBufferValid())
+    if(m_backend == EvaluationBackend::Cpu)
+      return;
+
+    m_volumeSumCompute.submitReadbacks();
+    while(ReadGpuResult(isWaitingForGpuResult()))
+      ;
+  }
+
+  // Consumes the oldest GPU result, false if there is none (or it isn't ready and wait is false)
+  bool ReadGpuResult(bool wait)
+  {
+    uint64_t requestId = 0;
+    float    result    = 0;
+    if(!m_volumeSumCompute.readResult(requestId, result, wait))
+      return false;
+
+    Evaluation evaluation = gpuEvaluations.front();
+    gpuEvaluations.pop_front();
+    assert(evaluation.requestId == requestId);
+
+    OnVolumeResult(evaluation, result);
+    return true;
+  }
+
+  // The readback ring is full or the current request can't continue without a result in flight
+  bool isWaitingForGpuResult() const
+  {
+    if(!m_volumeSumCompute.hasFreeReadbackSlot())
+      return true;
+    if(!m_algo->isAlgorithmRunning() || !cameraChangeRequested)
+      return false;
+
+    if(auto* batch = std::get_if<AlgoRequestBatch>(&algoRequest))
+      return batchIssued == batch->rotations.size() && batchReceived < batch->rotations.size();
+    return requestIssued && !volumeReady;
+  }
+
+  // Rotation of the current request still has to be evaluated (the viewport is evaluated every frame)
+  bool hasEvaluationToIssue() const
+  {
+    if(!m_algo->isAlgorithmRunning() || !cameraChangeRequested)
+      return true;
+
+    if(auto* batch = std::get_if<AlgoRequestBatch>(&algoRequest))
+      return batchIssued < batch->rotations.size();
+    return !requestIssued;
+  }
+
+  // Evaluation of the current view, advances the current request
+  Evaluation issueEvaluation()
+  {
+    Evaluation evaluation{.rotation        = lastRotation,
+                          .viewInvMatrix   = viewInvMatrix,
+                          .position        = lastPosition,
+                          .lod             = currentLod,
+                          .resolutionLevel = currentResolutionLevel,
+                          .analytic        = analyticVolumeValid,
+                          .forAlgorithm    = m_algo->isAlgorithmRunning() && cameraChangeRequested};
+    if(evaluation.forAlgorithm)
     {
-      VkCommandBuffer copyCmd = m_app->createTempCmdBuffer();
-      m_volumeSumCompute.recordCopyResultToStaging(copyCmd);
-      m_app->submitAndWaitTempCmdBuffer(copyCmd);
+      if(std::holds_alternative<AlgoRequestBatch>(algoRequest))
+        evaluation.batchIndex = (int)batchIssued++;
+      else
+        requestIssued = true;
+    }
+    return evaluation;
+  }
 
-      volume = m_volumeSumCompute.readResult();
+  // Result of an evaluation, immediate on the CPU and a few frames later on the GPU
+  void OnVolumeResult(const Evaluation& evaluation, float result)
+  {
+    volume         = result;
+    volumeRotation = evaluation.rotation;
 
-      if(minVolume > volume)
-      {
-        minVolume    = volume;
-        bestRotation = viewInvMatrix;
-        bestPosition = lastPosition;
-      }
+    // Results of the viewport during a run (or of a stopped run) are only shown
+    if(evaluation.forAlgorithm != m_algo->isAlgorithmRunning())
+      return;
+
+    updateBestResult(evaluation, result);
+    if(!evaluation.forAlgorithm)
+      return;
+
+    if(evaluation.batchIndex >= 0)
+    {
+      batchResults[evaluation.batchIndex] = {result, evaluation.rotation};
+      batchReceived++;
     }
     else
     {
-      // Note: this has to be called on next frame after rendering is done
-      // First frame doesn't have a reference to a buffer yet
-      std::cout << "First frame, skipping getting calculation result\n\n";
+      volumeReady = true;
     }
   }
 
+  // New request of the algorithm, nothing evaluated yet
+  void resetRequestProgress()
+  {
+    auto* batch   = std::get_if<AlgoRequestBatch>(&algoRequest);
+    requestIssued = false;
+    volumeReady   = false;
+    batchIssued   = 0;
+    batchReceived = 0;
+    batchResults.assign(batch != nullptr ? batch->rotations.size() : 0, RendererResult{});
+  }
+
+  // Best result of the current run
+  // Analytic estimates, coarse levels of detail and coarse grids are skipped, the saved result always comes from the
+  // selected backend on the full mesh at the selected resolution
+  void updateBestResult(const Evaluation& evaluation, float result)
+  {
+    if(!evaluation.analytic && evaluation.lod == 0 && evaluation.resolutionLevel == 0 && minVolume > result)
+    {
+      minVolume    = result;
+      bestRotation = evaluation.viewInvMatrix;
+      bestPosition = evaluation.position;
+    }
+  }
+
+  // Evaluates all but the last rotation of a batch request in this frame if the volume is calculated on the CPU
+  // (cpu backend or analytic estimate), the last rotation is evaluated by the usual per frame path
+  // On the GPU one rotation is recorded per frame and the batch stays in flight in the readback ring
+  void EvaluateBatchOnCpu()
+  {
+    auto* batch = std::get_if<AlgoRequestBatch>(&algoRequest);
+    if(!m_algo->isAlgorithmRunning() || !cameraChangeRequested || batch == nullptr)
+      return;
+
+    while(batchIssued + 1 < batch->rotations.size())
+    {
+      RecalculateAABB();
+      updateResolution();
+
+      float result = 0;
+      if(EvaluateVolumeAnalytic())
+        result = analyticVolume;
+      else if(m_backend == EvaluationBackend::Cpu)
+        result = getCpuEvaluator(currentLod).evaluate(getVolumeEvaluationView());
+      else
+        break;  // GPU
+
+      OnVolumeResult(issueEvaluation(), result);
+
+      // Next rotation of the batch
+      updateViewMatrixFromCamera();
+    }
+  }
+
+  // Times the separate and the fused volume passes on the current height field, both have to give the same volume
+  // The readback ring has to be empty
+  void BenchmarkVolumePasses(unsigned int iterations)
+  {
+    if(!m_fusedVolumeSupported)
+    {
+      std::cout << "[Volume] benchmark skipped, fused pass not supported\n";
+      return;
+    }
+
+    auto run = [&](bool fused, float& result) {
+      VkCommandBuffer cmd   = m_app->createTempCmdBuffer();
+      auto            start = std::chrono::steady_clock::now();
+      for(unsigned int i = 0; i < iterations; ++i)
+        CalculateVolume(cmd, fused);
+      m_volumeSumCompute.recordCopyResultToStaging(cmd, 0);
+      m_app->submitAndWaitTempCmdBuffer(cmd);
+      auto time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+      uint64_t requestId = 0;
+      m_volumeSumCompute.submitReadbacks();
+      m_volumeSumCompute.readResult(requestId, result, true);
+      return time.count() / iterations;
+    };
+
+    float separateVolume = 0;
+    float fusedVolume    = 0;
+    run(true, fusedVolume);  // warm up
+    double separateTime = run(false, separateVolume);
+    double fusedTime    = run(true, fusedVolume);
+
+    std::cout << std::format("[Volume] {}x{}, {} evaluations: separate {:.4f} ms ({}), fused {:.4f} ms ({}), speedup {:.2f}x\n",
+                             m_currentRenderResolution.width, m_currentRenderResolution.height, iterations, separateTime,
+                             separateVolume, fusedTime, fusedVolume, separateTime / fusedTime);
+  }
+
   bool RunAlgorithm()
   {
     AlgoRequestAny response{};
 
     if(m_algo->isAlgorithmRunning())
     {
-      // Run algorithm
-      response = m_algo->runAlgorithm({volume, m_camera->getRotation()});
+      auto* batch = std::get_if<AlgoRequestBatch>(&algoRequest);
+      if(batch != nullptr && cameraChangeRequested)
+      {
+        // Collect all results of the batch before running the algorithm
+        if(batchReceived < batch->rotations.size())
+          return true;
+
+        response = m_algo->runAlgorithm(std::move(batchResults));
+      }
+      else
+      {
+        if(!volumeReady)
+          return true;
+
+        // Run algorithm
+        response = m_algo->runAlgorithm({volume, m_camera->getRotation()});
+      }
     }
     else if(startAlgorithm)
     {
+      // Results of the viewport still in flight don't belong to the run
+      while(ReadGpuResult(true))
+        ;
+
+      if(inputs.volumeBenchmark > 0 && current_run == 0 && m_backend == EvaluationBackend::Gpu)
+        BenchmarkVolumePasses(inputs.volumeBenchmark);
+
       // Reset best
       minVolume = std::numeric_limits<float>().max();
 
       std::cout << "starting algorithm...\n";
       // Request to start the algorithm
       algoStartTime = std::chrono::steady_clock::now();
-      response      = m_algo->startAlgorithm(selectedAlgo, inputs.maxEvals);
+      m_algo->setRollInvariant(inputs.rollInvariant);
+      m_algo->setSeedDirections(m_facetSeeds->getDirections());
+      m_algo->setProxy([this](const glm::quat& rotation) { return m_overhangProxy->evaluate(rotation * glm::vec3(0, 0, 1)); });
+      m_algo->setLowerBound([this](const glm::quat& rotation) {
+        // View z in model space (view matrix is the inverse rotation)
+        return m_hullBound->lowerBound(rotation * glm::vec3(0, 0, 1)) * (1.0f - inputs.boundMargin);
+      });
+      response = m_algo->startAlgorithm(selectedAlgo, inputs.maxEvals,
+                                        {inputs.cacheTolerance, getEvaluationCacheFile(), getRunSettings()});
       m_camera->disableInteractive();
       startAlgorithm = false;
     }
@@ -1295,6 +1855,19 @@ public:
       std::cout << "Program init took " << programInitTime << "\n";
       auto algo_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - algoStartTime);
       std::cout << "Algorithm finished in: " << algo_time << "\n";
+      if(m_backend == EvaluationBackend::Cpu)
+      {
+        m_cpuEvaluator->printStats();
+        for(size_t i = 0; i < m_cpuLodEvaluators.size(); ++i)
+        {
+          if(!m_cpuLodEvaluators[i])
+            continue;
+          std::cout << "[LOD " << i + 1 << "]\n";
+          m_cpuLodEvaluators[i]->printStats();
+        }
+      }
+      if(m_analyticEvaluator)
+        m_analyticEvaluator->printStats();
 
       if(m_algo->isAlgorithmDone())
       {
@@ -1317,6 +1890,8 @@ public:
           algoStats.init_time_ms    = programInitTime.count();
           algoStats.result          = minVolume;
           algoStats.position        = bestPosition;
+          algoStats.cache_hit_rate  = m_algo->getCache().getHitRate();
+          algoStats.optimality_gap  = m_algo->getOptimalityGap().value_or(-1);
           append_record(inputs.outputStats, algoStats);
         }
         if(++current_run < inputs.runs)
@@ -1342,7 +1917,8 @@ public:
 
       if(inputs.closeOnDone)
       {
-        this->m_app->close();
+        if(m_app != nullptr)
+          this->m_app->close();
         return false;
       }
     }
@@ -1358,6 +1934,15 @@ public:
     {
       std::cout << "done...\n";
 
+      // Best evaluation of the run, only known by the cache if the run was loaded from it
+      if(auto best = m_algo->getBestResult(); best && best->volume < minVolume)
+      {
+        m_camera->setRotation(best->rotation);
+        minVolume    = best->volume;
+        bestRotation = glm::inverse(m_camera->getViewMatrix());
+        bestPosition = m_camera->getPosition();
+      }
+
       // Read result
       auto result = m_algo->getAlgorithmResult();
       m_camera->setRotation(result.bestRotation);
@@ -1372,6 +1957,7 @@ public:
 
       cameraChangeRequested = true;
       algoRequest           = request;
+      resetRequestProgress();
     }
 
     auto requestBase = std::visit([](AlgoRequestBase& r) { return r; }, request);
@@ -1401,6 +1987,7 @@ public:
                        [&](AlgoRequestMoveDir& r) { m_camera->move(r.moveDirection); },
                        [&](AlgoRequestNewQuat& r) { m_camera->setRotation(r.newQuat); },
                        [&](AlgoRequestNewPos& r) { m_camera->setPositionOnSphere(r.newPosition); },
+                       [&](AlgoRequestBatch& r) { m_camera->setRotation(r.rotations[batchIssued]); },
                    },
                    algoRequest);
       }
@@ -1434,11 +2021,23 @@ public:
 
     // Run step
     float normalized_volume = volume / (float)maxVolume;
-    pythonVolumeForwarder.get()->RunStep(lastRotation, normalized_volume, forwardVolumeToPython,
+    pythonVolumeForwarder.get()->RunStep(volumeRotation, normalized_volume, forwardVolumeToPython,
                                          forwardPositionToPython, pythonForwarderPointSize, pythonForwarderClear);
   }
 
   void LoadStlData(VkCommandBuffer cmd)
+  {
+    LoadMesh();
+
+    // Import the data, levels of detail follow the full mesh (mesh i is level i)
+    nvsamples::importStlData(m_sceneResource, triangles, m_stagingUploader);
+    for(const auto& level : meshLods)
+      nvsamples::importStlData(m_sceneResource, level.triangles, m_stagingUploader);
+    m_aabbCompute.init(cmd, &m_allocator, std::span(aabb_compute_slang), aabbVertices);
+  }
+
+  // Triangles and everything the CPU derives from them (levels of detail, convex hull, AABB vertices)
+  void LoadMesh()
   {
     // Load and parse the data from file
     if(inputs.inputStl == "")
@@ -1507,11 +2106,87 @@ public:
       triangles = nvsamples::loadStlResources(inputs.inputStl);
     }
 
-    // Import the data
-    nvsamples::importStlData(m_sceneResource, triangles, m_stagingUploader);
-    auto vertices = nvsamples::exportVerticesFromStlTriangles(triangles);
-    m_aabbCompute.init(cmd, &m_allocator, std::span(aabb_compute_slang), vertices);
+    aabbVertices = nvsamples::exportVerticesFromStlTriangles(triangles);
+
+    // The AABB is always the one of the full mesh
+    BuildMeshLods();
+
+    // Lower bound of the volume for branch and bound, same metric as the selected pipeline
+    auto hullStart = std::chrono::steady_clock::now();
+    m_hullBound    = std::make_unique<HullBound>(triangles, inputs.raytraced ? AnalyticEvaluator::Metric::Support :
+                                                                              AnalyticEvaluator::Metric::HeightField);
+    std::cout << "[Hull] vertices: " << m_hullBound->getHull().getVertices().size()
+              << ", faces: " << m_hullBound->getHull().getFaces().size()
+              << ", facets on the hull: " << m_hullBound->getBoundaryFacetCount() << ", built in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - hullStart) << "\n";
+
+    // Extremes of the mesh in any direction are hull vertices, flat meshes have no hull
+    if(m_hullBound->getHull().isValid())
+      m_cpuAabb = std::make_unique<CpuAabb>(m_hullBound->getHull().getVertices());
+    else
+      m_cpuAabb = std::make_unique<CpuAabb>(aabbVertices);
+    std::cout << "[AABB] cpu vertices: " << m_cpuAabb->getVertexCount() << " of " << aabbVertices.size()
+              << (m_cpuAabb->usesAvx2() ? ", avx2" : ", scalar") << "\n";
+
+    // Facet normals are binned once for the seeds and the proxy
+    auto                         binsStart  = std::chrono::steady_clock::now();
+    const std::vector<NormalBin> normalBins = binFacetNormals(triangles, NORMAL_BIN_SIZE);
+    std::cout << "[Normals] bins: " << normalBins.size() << ", built in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - binsStart) << "\n";
+
+    auto        seedsStart = std::chrono::steady_clock::now();
+    m_facetSeeds           = std::make_unique<FacetSeeds>(normalBins);
+    const auto& seeds      = m_facetSeeds->getSeeds();
+    std::cout << "[Seeds] " << seeds.size() << " facet clusters, largest "
+              << (seeds.empty() ? 0.0f : 100.0f * seeds.front().area / m_facetSeeds->getTotalArea()) << "% of the area, built in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - seedsStart) << "\n";
+
+    m_overhangProxy      = std::make_unique<OverhangProxy>(normalBins, glm::radians(inputs.overhangAngle));
+    m_overhangProxyAngle = inputs.overhangAngle;
+  }
+  // Every level has about lodRatio of the triangles of the previous one, levels stop at the error bound
+  void BuildMeshLods()
+  {
+    meshLods.clear();
+    if(inputs.lodLevels <= 0)
+      return;
+
+    auto           lodStart = std::chrono::steady_clock::now();
+    MeshSimplifier simplifier(triangles);
+
+    std::vector<size_t> targets;
+    size_t              target = simplifier.getFaceCount();
+    for(int i = 0; i < std::min(inputs.lodLevels, MAX_LOD_LEVELS); ++i)
+    {
+      target = (size_t)((float)target * inputs.lodRatio);
+      targets.push_back(target);
+    }
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for(const auto& v : aabbVertices)
+    {
+      boundsMin = glm::min(boundsMin, glm::vec3(v));
+      boundsMax = glm::max(boundsMax, glm::vec3(v));
+    }
+    const float maxError = inputs.lodMaxError * glm::distance(boundsMin, boundsMax);
+
+    for(auto& level : simplifier.simplify(targets, maxError))
+    {
+      // Level that barely reduces the previous one isn't worth evaluating
+      size_t previous = meshLods.empty() ? triangles.size() : meshLods.back().triangles.size();
+      if((float)level.triangles.size() > (float)previous * LOD_MIN_REDUCTION)
+        break;
+      meshLods.push_back(std::move(level));
+    }
+
+    for(size_t i = 0; i < meshLods.size(); ++i)
+      std::cout << "[LOD " << i + 1 << "] triangles: " << meshLods[i].triangles.size() << " of " << triangles.size()
+                << ", error: " << meshLods[i].error << "\n";
+    std::cout << "[LOD] built in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - lodStart) << "\n";
   }
+
   void SaveResult()
   {
     if(errorThrown)
@@ -1558,6 +2233,12 @@ public:
     currentResolutionChanged = true;
   }
 
+  // Grid size of the current resolution level, halved per level down to 2 points
+  unsigned int scaleResolution(int size) const
+  {
+    return (unsigned int)(currentResolutionLevel == 0 ? size : std::max(size >> currentResolutionLevel, 2));
+  }
+
   void updateResolution()
   {
     float width  = aabbMax.x - aabbMin.x;
@@ -1583,10 +2264,11 @@ public:
       }
     }
 
-    if(currentResolutionChanged || useFixedAreaResolution)
+    if(currentResolutionChanged || useFixedAreaResolution || currentResolutionLevel != renderResolutionLevel)
     {
-      m_currentRenderResolution = {(unsigned int)currentResolutionWidth, (unsigned int)currentResolutionHeight};
+      m_currentRenderResolution = {scaleResolution(currentResolutionWidth), scaleResolution(currentResolutionHeight)};
       currentResolutionChanged  = false;
+      renderResolutionLevel     = currentResolutionLevel;
     }
     /*if(maxResolutionChanged)
     {
@@ -1631,11 +2313,19 @@ private:
   bool startAlgorithm = false;
 
   // Set by algorithm (info for camera)
-  shaderio::float2 moveDirection{};
-  glm::quat        newQuat{};
-  shaderio::float3 newPosition{};
-  bool             cameraChangeRequested = false;
-  AlgoRequestAny   algoRequest;
+  shaderio::float2            moveDirection{};
+  glm::quat                   newQuat{};
+  shaderio::float3            newPosition{};
+  bool                        cameraChangeRequested = false;
+  AlgoRequestAny              algoRequest;
+  std::vector<RendererResult> batchResults;           // results of the current AlgoRequestBatch, by rotation index
+  size_t                      batchIssued   = 0;      // rotations of the batch evaluated or in flight
+  size_t                      batchReceived = 0;
+  bool                        requestIssued = false;  // other requests: the rotation is evaluated or in flight
+  bool                        volumeReady   = false;  // other requests: volume is the result of the rotation
+
+  std::deque<Evaluation> gpuEvaluations;  // waiting for their readback
+  uint64_t               nextRequestId = 0;
 
   // Other
   bool  useFixedAreaResolution = false;  // fixed width x height
@@ -1647,9 +2337,14 @@ private:
   nvshaders::VolumeIntegrateCompute m_volumeIntegrateCompute{};
   // Volume calculation
   nvshaders::VolumeSumCompute m_volumeSumCompute{};
+  // Fused integration and reduction
+  nvshaders::VolumeFusedCompute m_volumeFusedCompute{};
+  bool                          m_fusedVolumeSupported = false;
+  bool                          m_useFusedVolume       = false;
   nvvk::Buffer                m_outVolumeBuffer;              // Buffer for volume calculations
   nvvk::Buffer                m_outVolumeBufferForReduction;  // Buffer for volume reduction
   float                       volume    = 0;
+  glm::quat                   volumeRotation{};  // rotation of the last result
   float                       maxVolume = 0;
   float                       minVolume = std::numeric_limits<float>().max();
   shaderio::float4x4          bestRotation{};  // Used to save the result
@@ -1663,6 +2358,34 @@ private:
   glm::vec3              aabbMax{40, 40, 40};
   // Used to calculate AABB
   std::vector<openstl::Triangle> triangles;
+  std::vector<shaderio::float3>  aabbVertices;  // Unique vertices
+  std::unique_ptr<CpuAabb>       m_cpuAabb;     // Convex hull vertices (CPU AABB)
+
+  // CPU backend
+  EvaluationBackend                m_backend = EvaluationBackend::Gpu;
+  std::unique_ptr<VolumeEvaluator> m_cpuEvaluator;
+
+  // Analytic estimate (EvaluationMode::Analytic requests), created on the first request
+  std::unique_ptr<AnalyticEvaluator> m_analyticEvaluator;
+  float                              analyticVolume      = 0;
+  bool                               analyticVolumeValid = false;  // Last evaluation is analytic
+
+  // Convex hull lower bound for branch and bound, built with the mesh
+  std::unique_ptr<HullBound> m_hullBound;
+
+  // Face down directions of the largest facet clusters, start points of the algorithms
+  std::unique_ptr<FacetSeeds> m_facetSeeds;
+
+  // Overhang area of any build direction, pre-filter of the global sweeps
+  std::unique_ptr<OverhangProxy> m_overhangProxy;
+  float                          m_overhangProxyAngle = 0.0f;  // overhangAngle the proxy was built with (degrees)
+
+  // Levels of detail, meshLods[i] is level i + 1 (level 0 is the full mesh)
+  static constexpr int   MAX_LOD_LEVELS    = 7;     // instance mask of the TLAS has 8 bits, one per level
+  static constexpr float LOD_MIN_REDUCTION = 0.8f;  // max triangles of a level relative to the previous one
+  std::vector<MeshSimplifier::Level>            meshLods;
+  std::vector<std::unique_ptr<VolumeEvaluator>> m_cpuLodEvaluators;  // cpu backend, created on the first request
+  int                                           currentLod = 0;      // level of detail evaluated in the last frame
 
   // CPU helper variables
   shaderio::float4x4 viewMatrix{};
@@ -1678,6 +2401,11 @@ private:
   bool       maxResolutionChanged     = false;
   bool       currentResolutionChanged = false;
 
+  // Coarse grids of the algorithm requests, level i halves the resolution i times
+  static constexpr int MAX_RESOLUTION_LEVEL   = 8;
+  int                  currentResolutionLevel = 0;  // resolution level evaluated in the last frame
+  int                  renderResolutionLevel  = 0;  // resolution level of m_currentRenderResolution
+
 
   // Application and core components
   nvapp::Application*     m_app{};            // The application framework
@@ -1758,10 +2486,13 @@ int main(int argc, char** argv)
 
   // Algorithm to run
   reg.add({"algorithm", algoString}, &inputs.algorithm);
-  reg.add({"raytraced", "uses ray tracing for calculations (slower)."}, &inputs.raytraced, true);
+  reg.add({"raytraced", "uses ray tracing for calculations (slower). With the cpu backend rays are cast on the CPU."}, &inputs.raytraced, true);
+  reg.add({"backend", "Volume evaluation backend {gpu, cpu}. cpu doesn't require GPU for calculations"}, &inputs.backend);
+  reg.add({"cpuKernel", "SIMD kernel of the cpu backend {auto, scalar, avx2, avx512}. scalar also disables ray packets"}, &inputs.cpuKernel);
 
   // Headless requires algorithm to run
-  reg.add({"headless", "Run in headless mode. Always closes on done. Requires algorithm to be specified"}, &inputs.headless, true);
+  reg.add({"headless", "Run in headless mode. Always closes on done. Requires algorithm to be specified. With the cpu backend Vulkan isn't initialized"},
+          &inputs.headless, true);
   reg.add({"closeOnDone", "True: closes when algorithm is done. Overriden by headless"}, &inputs.closeOnDone, true);
 
   // Resolution
@@ -1781,6 +2512,35 @@ int main(int argc, char** argv)
   reg.add({"maxEvals", "Maximum number of evaluations (force stop after maxEvals is exceeded)"}, &inputs.maxEvals);
   reg.add({"outputStats", "Where to save/append statistics"}, &inputs.outputStats);
 
+  // Cache
+  reg.add({"cacheTolerance", "Rotations closer than this (radians) share one evaluation. 0 disables the cache"}, &inputs.cacheTolerance);
+  reg.add({"cacheDir", "Directory of the persistent evaluation cache, reused by later runs on the same mesh"}, &inputs.cacheDir);
+  reg.add({"rollInvariant", "Removes the camera roll of every requested rotation (search only the build direction)"},
+          &inputs.rollInvariant, true);
+  reg.add({"boundMargin", "Branch and bound skips a rotation if its lower bound * (1 - boundMargin) is above the best volumes"},
+          &inputs.boundMargin);
+  reg.add({"overhangAngle", "Overhang angle from the vertical (degrees) of the proxy used to pre-filter the global sweeps"},
+          &inputs.overhangAngle);
+
+  // Levels of detail
+  reg.add({"lodLevels", "Number of simplified meshes for coarse evaluations (max 7). 0 disables"}, &inputs.lodLevels);
+  reg.add({"lodRatio", "Triangles of a level of detail relative to the previous level"}, &inputs.lodRatio);
+  reg.add({"lodMaxError", "Max RMS distance of a level of detail from the mesh, relative to the mesh bounding box diagonal"},
+          &inputs.lodMaxError);
+
+  // AABB
+  reg.add({"gpuAabb", "Computes the AABB of every rotation on the GPU instead of the CPU (convex hull vertices)"},
+          &inputs.gpuAabb, true);
+
+  // Readback
+  reg.add({"readbackSlots", "GPU volume results in flight, batches of rotations are pipelined over this many frames"},
+          &inputs.readbackSlots);
+
+  // Volume passes
+  reg.add({"fusedVolume", "Integrates and reduces the height field in one subgroup pass"}, &inputs.fusedVolume, true);
+  reg.add({"volumeBenchmark", "Times the separate and the fused volume passes with this many evaluations on start. 0 disables"},
+          &inputs.volumeBenchmark);
+
   // Internal
   reg.add({"outputQuat", "Where to save resulting quaternion"}, &inputs.outputQuat);
   reg.add({"vertsFile", "Verts file to read (used by Cura plugin)"}, &inputs.vertsFile);
@@ -1834,6 +2594,26 @@ int main(int argc, char** argv)
     return handleExit(EXIT_FAILURE);
   }
 
+  // Headless cpu backend never needs the GPU, no Vulkan context or application
+  if(inputs.headless && inputs.backend == "cpu")
+  {
+    int  error_code        = EXIT_SUCCESS;
+    auto g_code_optimizer2 = std::make_shared<GCodeOptimizer2>(inputs);
+    g_code_optimizer2->m_camera         = std::make_shared<nvapp::CustomCamera>();
+    g_code_optimizer2->m_algo           = std::make_unique<AlgorithmSync>();
+    g_code_optimizer2->programStartTime = programStartTime;
+    try
+    {
+      g_code_optimizer2->runComputeOnly();
+    }
+    catch(const std::exception& e)
+    {
+      std::cerr << "Error: " << e.what() << "\n";
+      error_code = EXIT_FAILURE;
+    }
+    return handleExit(error_code);
+  }
+
   // Setting up the Vulkan context, instance and device extensions
   VkPhysicalDeviceShaderObjectFeaturesEXT shaderObjectFeatures{.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT};
 
@@ -1953,6 +2733,8 @@ int main(int argc, char** argv)
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(GCodeOptimizer2::Inputs,
                                    algorithm,
                                    raytraced,
+                                   backend,
+                                   cpuKernel,
                                    headless,
                                    closeOnDone,
                                    textureResolution,
@@ -1962,6 +2744,18 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(GCodeOptimizer2::Inputs,
                                    runs,
                                    maxEvals,
                                    outputStats,
+                                   cacheTolerance,
+                                   cacheDir,
+                                   rollInvariant,
+                                   boundMargin,
+                                   overhangAngle,
+                                   lodLevels,
+                                   lodRatio,
+                                   lodMaxError,
+                                   gpuAabb,
+                                   readbackSlots,
+                                   fusedVolume,
+                                   volumeBenchmark,
                                    outputQuat,
                                    vertsFile,
                                    indsFile)
@@ -1969,4 +2763,4 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(GCodeOptimizer2::Inputs,
 namespace glm {
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(vec3, x, y, z)
 }  // namespace glm
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(GCodeOptimizer2::AlgoStats, algo_name, model_name, init_time_ms, algo_time_ms, algo_iterations, result, position)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(GCodeOptimizer2::AlgoStats, algo_name, model_name, init_time_ms, algo_time_ms, algo_iterations, result, position, cache_hit_rate, optimality_gap)
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// FNV-1a, stable between runs and platforms (used for cache keys and file names)
+inline constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for(size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+inline uint64_t hashString(std::string_view text, uint64_t hash = FNV_OFFSET_BASIS)
+{
+  return hashBytes(text.data(), text.size(), hash);
+}
@@ -39,6 +39,7 @@ struct RtxPushConstant
   float3         aabbMin;           // start of bounding box for volume calculation
   float3         aabbMax;           // end of bounding box for volume calculation
   float			 maxSupportHeight;  // maximum support height (used for visualization only)
+  uint           instanceMask;      // instances to trace, one bit per level of detail
 };
 
 
@@ -107,4 +108,20 @@ struct VolumeIntegratePushConstant{
   float2 area_size;
 };
 
+// Fused integration and reduction
+#define VOLUME_FUSED_SHADER_WG_SIZE 256
+#define VOLUME_FUSED_MAX_GROUPS 1024  // partial sums fit one volumesum group (WG * elemsPerThread)
+
+enum volume_fused_Binding
+{
+  fInImage = 0,
+  fOutPartial = 1
+};
+
+struct VolumeFusedPushConstant{
+  uint2 image_size;
+  float2 area_size;
+  uint group_count;
+};
+
 NAMESPACE_SHADERIO_END()
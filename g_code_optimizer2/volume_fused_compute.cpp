@@ -0,0 +1,124 @@
+#include <algorithm>
+
+#include "volume_fused_compute.hpp"
+#include <nvvk/barriers.hpp>
+#include <nvvk/check_error.hpp>
+#include <nvvk/commands.hpp>
+#include <nvvk/compute_pipeline.hpp>
+#include <nvvk/debug_util.hpp>
+#include <nvvk/default_structs.hpp>
+
+#include <cmath>
+
+VkResult nvshaders::VolumeFusedCompute::init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv)
+{
+  assert(!m_device);
+  m_alloc  = alloc;
+  m_device = alloc->getDevice();
+
+  // Result buffer of VolumeSumCompute when there is a single group, copied to staging
+  alloc->createBuffer(m_partialBuffer, VOLUME_FUSED_MAX_GROUPS * sizeof(float),
+                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_AUTO);
+  NVVK_DBG_NAME(m_partialBuffer.buffer);
+
+  // Shader descriptor set layout
+  nvvk::DescriptorBindings bindings;
+  bindings.addBinding(shaderio::volume_fused_Binding::fInImage, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+  bindings.addBinding(shaderio::volume_fused_Binding::fOutPartial, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT);
+
+  NVVK_CHECK(m_descriptorPack.init(bindings, m_device, 0, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR));
+  NVVK_DBG_NAME(m_descriptorPack.getLayout());
+
+  // Push constant
+  VkPushConstantRange pushConstantRange{.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                                        .size       = sizeof(shaderio::VolumeFusedPushConstant)};
+
+  // Pipeline layout
+  const VkPipelineLayoutCreateInfo pipelineLayoutInfo{
+      .sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+      .setLayoutCount         = 1,
+      .pSetLayouts            = m_descriptorPack.getLayoutPtr(),
+      .pushConstantRangeCount = 1,
+      .pPushConstantRanges    = &pushConstantRange,
+  };
+  NVVK_FAIL_RETURN(vkCreatePipelineLayout(m_device, &pipelineLayoutInfo, nullptr, &m_pipelineLayout));
+  NVVK_DBG_NAME(m_pipelineLayout);
+
+  // Compute Pipeline
+  VkComputePipelineCreateInfo compInfo   = {VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+  VkShaderModuleCreateInfo    shaderInfo = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+  compInfo.stage                         = {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO};
+  compInfo.stage.stage                   = VK_SHADER_STAGE_COMPUTE_BIT;
+  compInfo.stage.pNext                   = &shaderInfo;
+  compInfo.layout                        = m_pipelineLayout;
+
+  shaderInfo.codeSize = uint32_t(spirv.size_bytes());  // All shaders are in the same spirv
+  shaderInfo.pCode    = spirv.data();
+
+  // Fused volume pipeline
+  compInfo.stage.pName = "IntegrateReduceVolume";
+  NVVK_FAIL_RETURN(vkCreateComputePipelines(m_device, nullptr, 1, &compInfo, nullptr, &m_volumeFusedPipeline));
+  NVVK_DBG_NAME(m_volumeFusedPipeline);
+
+  return VK_SUCCESS;
+}
+
+void nvshaders::VolumeFusedCompute::deinit()
+{
+  if(!m_device)
+    return;
+
+  vkDestroyPipeline(m_device, m_volumeFusedPipeline, nullptr);
+  vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
+  m_descriptorPack.deinit();
+
+  m_alloc->destroyBuffer(m_partialBuffer);
+
+  m_pipelineLayout      = VK_NULL_HANDLE;
+  m_volumeFusedPipeline = VK_NULL_HANDLE;
+  m_device              = VK_NULL_HANDLE;
+}
+
+uint32_t nvshaders::VolumeFusedCompute::runCompute(VkCommandBuffer  cmd,
+                                                   VkImageView      srcImageView,
+                                                   shaderio::uint2  textureSize,
+                                                   shaderio::float2 areaSize)
+{
+  const uint32_t texelCount = textureSize.x * textureSize.y;
+  const uint32_t groupCount =
+      std::clamp((uint32_t)std::ceil(texelCount / (double)(VOLUME_FUSED_SHADER_WG_SIZE * K)), 1u, (uint32_t)VOLUME_FUSED_MAX_GROUPS);
+
+  pushConst.image_size  = textureSize;
+  pushConst.area_size   = areaSize;
+  pushConst.group_count = groupCount;
+
+  // Push constant
+  vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(shaderio::VolumeFusedPushConstant), &pushConst);
+
+  nvvk::WriteSetContainer writeSetContainer;
+  writeSetContainer.append(m_descriptorPack.makeWrite(shaderio::volume_fused_Binding::fInImage), srcImageView, VK_IMAGE_LAYOUT_GENERAL);
+  writeSetContainer.append(m_descriptorPack.makeWrite(shaderio::volume_fused_Binding::fOutPartial), &m_partialBuffer);
+  vkCmdPushDescriptorSetKHR(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_pipelineLayout, 0, writeSetContainer.size(),
+                            writeSetContainer.data());
+
+  // Run
+  vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_volumeFusedPipeline);
+  vkCmdDispatch(cmd, groupCount, 1, 1);
+
+  // Barrier
+  nvvk::cmdMemoryBarrier(cmd, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+
+  return groupCount;
+}
+
+bool nvshaders::VolumeFusedCompute::isSupported(VkPhysicalDevice physicalDevice)
+{
+  VkPhysicalDeviceSubgroupProperties subgroupProperties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES};
+  VkPhysicalDeviceProperties2        prop2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+  prop2.pNext = &subgroupProperties;
+  vkGetPhysicalDeviceProperties2(physicalDevice, &prop2);
+
+  const VkSubgroupFeatureFlags required = VK_SUBGROUP_FEATURE_BASIC_BIT | VK_SUBGROUP_FEATURE_ARITHMETIC_BIT;
+  return (subgroupProperties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT)
+         && (subgroupProperties.supportedOperations & required) == required;
+}
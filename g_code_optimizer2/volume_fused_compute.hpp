@@ -0,0 +1,49 @@
+#pragma once
+#include <glm/glm.hpp>
+
+#include "vulkan/vulkan_core.h"
+#include "nvvk/resource_allocator.hpp"
+
+#include <nvutils/timers.hpp>
+#include <nvvk/descriptors.hpp>
+
+#include "shaders/shaderio.h"
+
+namespace nvshaders {
+
+// Trapezoid integration and reduction in one pass: n * m texels => one partial sum per group (at most
+// VOLUME_FUSED_MAX_GROUPS), the partial sums are reduced by VolumeSumCompute in a single dispatch
+// Needs subgroup arithmetic in compute shaders
+class VolumeFusedCompute
+{
+public:
+  VolumeFusedCompute() {};
+  ~VolumeFusedCompute() { assert(m_device == VK_NULL_HANDLE); }  //  "Missing to call deinit"
+
+  VkResult init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv);
+  void     deinit();
+
+  // Returns the number of partial sums written to the partial buffer
+  uint32_t runCompute(VkCommandBuffer cmd, VkImageView srcImageView, shaderio::uint2 textureSize, shaderio::float2 areaSize);
+
+  nvvk::Buffer* getPartialBuffer() { return &m_partialBuffer; }
+
+  static bool isSupported(VkPhysicalDevice physicalDevice);
+
+private:
+  nvvk::ResourceAllocator* m_alloc{};
+
+  VkDevice             m_device{};
+  nvvk::DescriptorPack m_descriptorPack;
+  VkPipelineLayout     m_pipelineLayout{};
+  VkPipeline           m_volumeFusedPipeline{};
+
+  nvvk::Buffer m_partialBuffer;
+
+  shaderio::VolumeFusedPushConstant pushConst{};
+
+  const shaderio::uint K = 4;  // min texels per thread before more groups are used
+};
+
+
+}  // namespace nvshaders
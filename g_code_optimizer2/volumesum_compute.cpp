@@ -9,15 +9,28 @@
 #include <nvvk/default_structs.hpp>
 
 
-VkResult nvshaders::VolumeSumCompute::init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv)
+VkResult nvshaders::VolumeSumCompute::init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, VkQueue queue, uint32_t readbackSlots)
 {
   assert(!m_device);
+  assert(readbackSlots > 0);
   m_alloc  = alloc;
   m_device = alloc->getDevice();
+  m_queue  = queue;
 
-  alloc->createBuffer(stagingBuffer, sizeof(float), VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT,
-                      VMA_MEMORY_USAGE_GPU_TO_CPU, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
-  NVVK_DBG_NAME(stagingBuffer.buffer);
+  // Readback ring
+  m_readbacks.resize(readbackSlots);
+  m_readbackFirst = 0;
+  m_readbackCount = 0;
+  for(auto& readback : m_readbacks)
+  {
+    alloc->createBuffer(readback.stagingBuffer, sizeof(float), VK_BUFFER_USAGE_2_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_2_TRANSFER_DST_BIT,
+                        VMA_MEMORY_USAGE_GPU_TO_CPU, VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
+    NVVK_DBG_NAME(readback.stagingBuffer.buffer);
+
+    const VkFenceCreateInfo fenceInfo{.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+    NVVK_FAIL_RETURN(vkCreateFence(m_device, &fenceInfo, nullptr, &readback.fence));
+    NVVK_DBG_NAME(readback.fence);
+  }
 
   // Shader descriptor set layout
   nvvk::DescriptorBindings bindings;
@@ -69,7 +82,20 @@ void nvshaders::VolumeSumCompute::deinit()
   vkDestroyPipelineLayout(m_device, m_pipelineLayout, nullptr);
   m_descriptorPack.deinit();
 
-  m_alloc->destroyBuffer(stagingBuffer);
+  // Fences of submitted readbacks may still be pending
+  for(uint32_t i = 0; i < m_readbackCount; ++i)
+  {
+    const Readback& readback = m_readbacks[(m_readbackFirst + i) % m_readbacks.size()];
+    if(readback.submitted)
+      vkWaitForFences(m_device, 1, &readback.fence, VK_TRUE, UINT64_MAX);
+  }
+  for(auto& readback : m_readbacks)
+  {
+    m_alloc->destroyBuffer(readback.stagingBuffer);
+    vkDestroyFence(m_device, readback.fence, nullptr);
+  }
+  m_readbacks.clear();
+  m_readbackCount = 0;
 
   m_pipelineLayout            = VK_NULL_HANDLE;
   m_volumeCalculationPipeline = VK_NULL_HANDLE;
@@ -113,19 +139,62 @@ void nvshaders::VolumeSumCompute::runCompute(VkCommandBuffer cmd, int elementCou
   resultBuffer = finalBuffer;
 }
 
-void nvshaders::VolumeSumCompute::recordCopyResultToStaging(VkCommandBuffer cmd)
+void nvshaders::VolumeSumCompute::recordCopyResultToStaging(VkCommandBuffer cmd, uint64_t requestId)
 {
+  assert(resultBuffer != nullptr);
+  assert(hasFreeReadbackSlot());  // caller reads a result first when the ring is full
+
+  Readback& readback = m_readbacks[(m_readbackFirst + m_readbackCount) % m_readbacks.size()];
+  readback.requestId = requestId;
+  readback.submitted = false;
+  m_readbackCount++;
+
   nvvk::cmdMemoryBarrier(cmd, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
   VkBufferCopy copyRegion{0, 0, sizeof(float)};
-  vkCmdCopyBuffer(cmd, resultBuffer->buffer, stagingBuffer.buffer, 1, &copyRegion);
+  vkCmdCopyBuffer(cmd, resultBuffer->buffer, readback.stagingBuffer.buffer, 1, &copyRegion);
 
   nvvk::cmdMemoryBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT);
+  // Next evaluation reuses the reduction buffers
+  nvvk::cmdMemoryBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+}
+
+void nvshaders::VolumeSumCompute::submitReadbacks()
+{
+  for(uint32_t i = 0; i < m_readbackCount; ++i)
+  {
+    Readback& readback = m_readbacks[(m_readbackFirst + i) % m_readbacks.size()];
+    if(readback.submitted)
+      continue;
+
+    // Empty submit, signaled when the frame command buffer with the copy is done
+    NVVK_CHECK(vkQueueSubmit(m_queue, 0, nullptr, readback.fence));
+    readback.submitted = true;
+  }
 }
 
-float nvshaders::VolumeSumCompute::readResult()
+bool nvshaders::VolumeSumCompute::readResult(uint64_t& requestId, float& result, bool wait)
 {
-  return reinterpret_cast<float*>(stagingBuffer.mapping)[0];
+  if(m_readbackCount == 0)
+    return false;
+
+  Readback& readback = m_readbacks[m_readbackFirst];
+  if(!readback.submitted)
+    return false;  // frame command buffer isn't submitted yet
+
+  if(wait)
+    NVVK_CHECK(vkWaitForFences(m_device, 1, &readback.fence, VK_TRUE, UINT64_MAX));
+  else if(vkGetFenceStatus(m_device, readback.fence) != VK_SUCCESS)
+    return false;
+
+  requestId = readback.requestId;
+  result    = reinterpret_cast<float*>(readback.stagingBuffer.mapping)[0];
+
+  NVVK_CHECK(vkResetFences(m_device, 1, &readback.fence));
+  readback.submitted = false;
+  m_readbackFirst    = (m_readbackFirst + 1) % m_readbacks.size();
+  m_readbackCount--;
+  return true;
 }
 
 int nvshaders::VolumeSumCompute::calculateMaxGroups(int elementCount)
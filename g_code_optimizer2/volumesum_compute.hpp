@@ -10,6 +10,8 @@
 
 #include "shaders/shaderio.h"
 
+#include <vector>
+
 namespace nvshaders {
 
 class VolumeSumCompute
@@ -18,13 +20,23 @@ public:
   VolumeSumCompute() {};
   ~VolumeSumCompute() { assert(m_device == VK_NULL_HANDLE); }  //  "Missing to call deinit"
 
-  VkResult init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv);
+  // queue: queue of the frame command buffers, fences of the readbacks are submitted to it
+  VkResult init(nvvk::ResourceAllocator* alloc, std::span<const uint32_t> spirv, VkQueue queue, uint32_t readbackSlots);
   void     deinit();
 
-  void  runCompute(VkCommandBuffer cmd, int elementCount, nvvk::Buffer* srcBuffer, nvvk::Buffer* dstBuffer);
-  void  recordCopyResultToStaging(VkCommandBuffer cmd);
-  bool  IsResultBufferValid() { return resultBuffer != nullptr; }
-  float readResult();
+  void runCompute(VkCommandBuffer cmd, int elementCount, nvvk::Buffer* srcBuffer, nvvk::Buffer* dstBuffer);
+
+  // Readback ring: every result is copied to its own staging buffer and tagged with the request id that produced it
+  // The copy is recorded into the frame command buffer, its fence is submitted by submitReadbacks() on the next frame
+  // (an empty submit signals once all earlier submissions are done)
+  void recordCopyResultToStaging(VkCommandBuffer cmd, uint64_t requestId);
+  void submitReadbacks();
+  // Oldest result in flight (results are read in the order they were recorded)
+  // Returns false if there is none or, without wait, if it isn't ready yet
+  bool readResult(uint64_t& requestId, float& result, bool wait);
+
+  bool     hasFreeReadbackSlot() const { return m_readbackCount < m_readbacks.size(); }
+  uint32_t getPendingReadbacks() const { return m_readbackCount; }
 
   int calculateMaxGroups(int elementCount);
 
@@ -36,7 +48,19 @@ private:
   VkPipelineLayout     m_pipelineLayout{};
   VkPipeline           m_volumeCalculationPipeline{};
 
-  nvvk::Buffer  stagingBuffer;
+  struct Readback
+  {
+    nvvk::Buffer stagingBuffer;
+    VkFence      fence     = VK_NULL_HANDLE;
+    uint64_t     requestId = 0;
+    bool         submitted = false;  // fence was submitted after the frame command buffer
+  };
+
+  VkQueue               m_queue{};
+  std::vector<Readback> m_readbacks;
+  uint32_t              m_readbackFirst = 0;  // oldest slot in flight
+  uint32_t              m_readbackCount = 0;
+
   nvvk::Buffer* resultBuffer = nullptr;
 
   shaderio::volume_Params params_data{};